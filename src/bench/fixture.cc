@@ -0,0 +1,226 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file fixture.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::bench::Fixture class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "bench/fixture.h"
+
+#include <fcntl.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "templimiter/error/io-error.h"
+#include "templimiter/tools/type-convert.h"
+
+namespace templimiter {
+
+namespace bench {
+
+namespace {
+
+/**
+ * @brief nftw callback that removes every visited path
+ *
+ * @return int 0 to continue the walk
+ */
+int remove_path(const char *path, const struct stat *, int, struct FTW *) {
+  std::remove(path);
+  return 0;
+}
+
+/**
+ * @brief Picks the parent directory of a fixture, preferring tmpfs
+ *
+ * @return std::string
+ */
+std::string default_base() {
+  if (::access("/dev/shm", W_OK) == 0) return "/dev/shm";
+  const char *tmpdir = ::getenv("TMPDIR");
+  return tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp";
+}
+
+}  // namespace
+
+void Fixture::make_dir_(const std::string &path) const {
+  if (::mkdir(path.c_str(), 0755) == -1 && errno != EEXIST) {
+    throw error::IOError(path, "mkdir");
+  }
+}
+
+void Fixture::write_file_(const std::string &path,
+                          const std::string &contents) const {
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd == -1) throw error::IOError(path, "open");
+  ssize_t n = ::write(fd, contents.data(), contents.size());
+  ::close(fd);
+  if (n != ssize_t(contents.size())) throw error::IOError(path, "write");
+}
+
+void Fixture::write_pid_stat_(size_t index, u_long utime) const {
+  std::string pid = tools::to_string(FIRST_PID_ + pid_t(index));
+  // Only the fields up to starttime are read; the rest keep the real layout
+  write_file_(root_ + "/proc/" + pid + "/stat",
+              pid + " (bench) R 1 " + pid + " " + pid + " 0 -1 4194304 0 0 " +
+                  "0 0 " + tools::to_string(utime) + " 0 0 0 20 0 1 0 " +
+                  tools::to_string(100 + index) +
+                  " 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 17 0 0 0 0 0 0 0 0 0 "
+                  "0 0 0 0 0\n");
+}
+
+void Fixture::write_proc_stat_() const {
+  // 100 jiffies per cpu per tick, a tenth of it busy
+  u_long busy = (ticks_ + 1) * 10;
+  u_long idle = (ticks_ + 1) * 90;
+  std::string cpu_times = " 0 " + tools::to_string(busy / 2) + " " +
+                          tools::to_string(idle) + " 0 0 0 0 0 0\n";
+  std::string contents = "cpu  " + tools::to_string(busy / 2 * cpus_) +
+                         " 0 " + tools::to_string(busy / 2 * cpus_) + " " +
+                         tools::to_string(idle * cpus_) + " 0 0 0 0 0 0\n";
+  for (size_t c = 0; c < cpus_; c++) {
+    contents +=
+        "cpu" + tools::to_string(c) + " " + tools::to_string(busy / 2) +
+        cpu_times;
+  }
+  contents += "intr 0\nctxt 0\nbtime 0\nprocesses " +
+              tools::to_string(procs_) + "\n";
+  write_file_(root_ + "/proc/stat", contents);
+}
+
+Fixture::Fixture(const std::string &base, size_t cpus, size_t zones,
+                 size_t procs, bool keep)
+    : cpus_(cpus), zones_(zones), procs_(procs), keep_(keep) {
+  std::string templ =
+      (base.empty() ? default_base() : base) + "/templimiter-bench.XXXXXX";
+  std::vector<char> path(templ.begin(), templ.end());
+  path.push_back('\0');
+  if (::mkdtemp(path.data()) == nullptr) throw error::IOError(templ, "mkdtemp");
+  root_ = path.data();
+
+  for (const char *dir :
+       {"/sys", "/sys/class", "/sys/class/thermal", "/sys/devices",
+        "/sys/devices/system", "/sys/devices/system/cpu", "/proc"}) {
+    make_dir_(root_ + dir);
+  }
+  for (size_t z = 0; z < zones_; z++) {
+    std::string dir =
+        root_ + "/sys/class/thermal/thermal_zone" + tools::to_string(z);
+    make_dir_(dir);
+    write_file_(dir + "/type", "bench\n");
+  }
+  set_temp(50000);
+  std::string available;
+  for (u_long f = MAX_FREQ_; f >= MIN_FREQ_; f -= 400000) {
+    available += tools::to_string(f) + " ";
+  }
+  for (size_t c = 0; c < cpus_; c++) {
+    std::string dir = root_ + "/sys/devices/system/cpu/cpu" +
+                      tools::to_string(c);
+    make_dir_(dir);
+    make_dir_(dir + "/cpufreq");
+    write_file_(dir + "/cpufreq/cpuinfo_max_freq",
+                tools::to_string(MAX_FREQ_) + "\n");
+    write_file_(dir + "/cpufreq/cpuinfo_min_freq",
+                tools::to_string(MIN_FREQ_) + "\n");
+    write_file_(dir + "/cpufreq/scaling_available_frequencies",
+                available + "\n");
+  }
+  reset_frequencies();
+  for (size_t i = 0; i < procs_; i++) {
+    make_dir_(root_ + "/proc/" + tools::to_string(FIRST_PID_ + pid_t(i)));
+    write_pid_stat_(i, 0);
+  }
+  write_proc_stat_();
+}
+
+Fixture::~Fixture() {
+  if (!keep_) ::nftw(root_.c_str(), remove_path, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+const std::string &Fixture::root() const { return root_; }
+
+std::string Fixture::write_config(const std::string &name, bool use_throttle,
+                                  bool use_SIGSTOP, uint scan_threads) const {
+  const std::string cpufreq = root_ + "/sys/devices/system/cpu/cpu*/cpufreq/";
+  std::string conf;
+  conf += "log_file_path            " + root_ + "/templimiter.log\n";
+  conf += "use_throttle             ";
+  conf += use_throttle ? "true\n" : "false\n";
+  conf += "use_SIGSTOP              ";
+  conf += use_SIGSTOP ? "true\n" : "false\n";
+  conf += "use_scaling_available    true\n";
+  conf += "use_thermal_events       false\n";
+  conf += "matcher_thermal          " + root_ +
+          "/sys/class/thermal/thermal_zone*/temp\n";
+  conf += "matcher_scaling_max_freq " + cpufreq + "scaling_max_freq\n";
+  conf += "matcher_cpuinfo_max_freq " + cpufreq + "cpuinfo_max_freq\n";
+  conf += "matcher_cpuinfo_min_freq " + cpufreq + "cpuinfo_min_freq\n";
+  conf += "matcher_scaling_available_frequencies " + cpufreq +
+          "scaling_available_frequencies\n";
+  conf += "proc_path                " + root_ + "/proc\n";
+  conf += "scan_threads             " + tools::to_string(scan_threads) + "\n";
+  conf += "temp_SIGSTOP             70000\n";
+  conf += "temp_SIGCONT             66000\n";
+  conf += "temp_throttle            66000\n";
+  conf += "temp_dethrottle          60000\n";
+  conf += "min_sleep                100\n";
+  std::string path = root_ + "/" + name;
+  write_file_(path, conf);
+  return path;
+}
+
+void Fixture::set_temp(u_long temp) const {
+  std::string contents = tools::to_string(temp) + "\n";
+  for (size_t z = 0; z < zones_; z++) {
+    write_file_(root_ + "/sys/class/thermal/thermal_zone" +
+                    tools::to_string(z) + "/temp",
+                contents);
+  }
+}
+
+void Fixture::reset_frequencies() const {
+  std::string contents = tools::to_string(MAX_FREQ_) + "\n";
+  for (size_t c = 0; c < cpus_; c++) {
+    write_file_(root_ + "/sys/devices/system/cpu/cpu" + tools::to_string(c) +
+                    "/cpufreq/scaling_max_freq",
+                contents);
+  }
+}
+
+void Fixture::advance() {
+  ticks_++;
+  write_proc_stat_();
+  for (size_t i = 0; i < procs_; i += BUSY_STRIDE_) {
+    // Busier processes sort higher among the stop candidates
+    write_pid_stat_(i, ticks_ * (1 + i % 7));
+  }
+}
+
+}  // namespace bench
+
+}  // namespace templimiter
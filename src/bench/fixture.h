@@ -0,0 +1,162 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file fixture.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::bench::Fixture class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+namespace templimiter {
+
+namespace bench {
+
+/**
+ * @brief Fake /sys and /proc trees for driving a Monitor without touching
+ * real hardware or processes
+ *
+ * Fake pids start above PID_MAX_LIMIT, so any signal that SIGSTOP mode sends
+ * to them fails with ESRCH instead of reaching a real process.
+ */
+class Fixture {
+ private:
+  /** @brief First fake pid (PID_MAX_LIMIT is 4194304) */
+  static constexpr pid_t FIRST_PID_ = 5000000;
+
+  /** @brief Every BUSY_STRIDE_th fake process accumulates cpu time */
+  static constexpr size_t BUSY_STRIDE_ = 50;
+
+  /** @brief Highest fake cpu frequency (in kHz) */
+  static constexpr u_long MAX_FREQ_ = 3000000;
+
+  /** @brief Lowest fake cpu frequency (in kHz) */
+  static constexpr u_long MIN_FREQ_ = 800000;
+
+  /** @brief Location of the fixture */
+  std::string root_;
+
+  /** @brief Number of fake cpus */
+  size_t cpus_;
+
+  /** @brief Number of fake thermal zones */
+  size_t zones_;
+
+  /** @brief Number of fake processes */
+  size_t procs_;
+
+  /** @brief Whether or not to leave the fixture behind on destruction */
+  bool keep_;
+
+  /** @brief Number of advance() calls */
+  u_long ticks_ = 0;
+
+  /**
+   * @brief Creates a directory
+   *
+   * @param path Directory to create
+   * @throw templimiter::error::IOError if the directory cannot be created
+   */
+  void make_dir_(const std::string &path) const;
+
+  /**
+   * @brief Creates or replaces a file
+   *
+   * @param path File to write
+   * @param contents New contents
+   * @throw templimiter::error::IOError if the file cannot be written
+   */
+  void write_file_(const std::string &path, const std::string &contents) const;
+
+  /**
+   * @brief Writes the stat file of a fake process
+   *
+   * @param index Index of the process
+   * @param utime User time (in jiffies)
+   */
+  void write_pid_stat_(size_t index, u_long utime) const;
+
+  /** @brief Writes /proc/stat for the current tick */
+  void write_proc_stat_() const;
+
+ public:
+  /**
+   * @brief Construct a new Fixture object, building both trees
+   *
+   * @param base Parent directory (a tmpfs such as /dev/shm is preferred when
+   * empty)
+   * @param cpus Number of fake cpus, each its own cpufreq policy
+   * @param zones Number of fake thermal zones
+   * @param procs Number of fake processes
+   * @param keep Whether or not to leave the fixture behind on destruction
+   * @throw templimiter::error::IOError if the fixture cannot be written
+   */
+  Fixture(const std::string &base, size_t cpus, size_t zones, size_t procs,
+          bool keep);
+
+  /** @brief Destroy the Fixture object, removing it unless kept */
+  ~Fixture();
+
+  Fixture(const Fixture &) = delete;
+  Fixture &operator=(const Fixture &) = delete;
+
+  /**
+   * @brief Returns the location of the fixture
+   * @return const std::string&
+   */
+  const std::string &root() const;
+
+  /**
+   * @brief Writes a configuration file whose matcher_* tags and proc_path
+   * point into the fixture
+   *
+   * @param name File name (relative to root())
+   * @param use_throttle Value of use_throttle
+   * @param use_SIGSTOP Value of use_SIGSTOP
+   * @param scan_threads Value of scan_threads
+   * @return std::string Location of the configuration file
+   */
+  std::string write_config(const std::string &name, bool use_throttle,
+                           bool use_SIGSTOP, uint scan_threads) const;
+
+  /**
+   * @brief Sets every thermal zone to one temperature
+   *
+   * @param temp Temperature (in millidegrees Celsius)
+   */
+  void set_temp(u_long temp) const;
+
+  /** @brief Sets every scaling_max_freq back to the highest frequency */
+  void reset_frequencies() const;
+
+  /**
+   * @brief Moves /proc/stat and the busy processes forward by one tick of
+   * cpu time
+   */
+  void advance();
+};
+
+}  // namespace bench
+
+}  // namespace templimiter
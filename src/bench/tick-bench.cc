@@ -0,0 +1,420 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file tick-bench.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Measures the latency, syscalls, and allocations of Monitor ticks
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bench/fixture.h"
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+#include "templimiter/daemon/monitor.h"
+#include "templimiter/error/argument-error.h"
+#include "templimiter/error/error.h"
+#include "templimiter/io/operations.h"
+#include "templimiter/tools/string.h"
+#include "templimiter/tools/type-convert.h"
+
+namespace {
+
+/** @brief Number of operator new calls made by the whole program */
+std::atomic<u_long> alloc_count{0};
+
+}  // namespace
+
+void *operator new(size_t size) {
+  alloc_count.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+namespace templimiter {
+
+namespace bench {
+
+namespace {
+
+/** @brief Lowest zone temperature of the triangle wave swept by the ticks */
+constexpr u_long TEMP_LOW = 55000;
+
+/** @brief Temperature change per tick (in millidegrees) */
+constexpr u_long TEMP_STEP = 1000;
+
+/** @brief Number of ticks from TEMP_LOW to the peak */
+constexpr u_long TEMP_RISE_TICKS = 20;
+
+/**
+ * @brief Counts syscalls of this process: exactly through the
+ * raw_syscalls:sys_enter tracepoint when perf allows it, or as read and write
+ * syscalls from /proc/self/io otherwise
+ */
+class SyscallCounter {
+ private:
+  /** @brief perf event descriptor, or -1 if using /proc/self/io */
+  int perf_fd_ = -1;
+
+  /** @brief Syscalls made by one /proc/self/io sample itself */
+  u_long sample_cost_ = 0;
+
+  /**
+   * @brief Opens a tracepoint counter
+   *
+   * @return true if counting exactly
+   * @return false if perf or tracefs is unavailable
+   */
+  bool open_perf_() {
+    for (const char *tracefs : {"/sys/kernel/tracing",
+                                "/sys/kernel/debug/tracing"}) {
+      std::ifstream id_file(std::string(tracefs) +
+                            "/events/raw_syscalls/sys_enter/id");
+      uint64_t id;
+      if (!(id_file >> id)) continue;
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_TRACEPOINT;
+      attr.size = sizeof(attr);
+      attr.config = id;
+      attr.inherit = 1;
+      perf_fd_ = int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (perf_fd_ != -1) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Reads the syscr and syscw counts of /proc/self/io
+   *
+   * @return u_long
+   */
+  static u_long read_proc_io_() {
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    u_long value;
+    u_long total = 0;
+    while (io >> key >> value) {
+      if (key == "syscr:" || key == "syscw:") total += value;
+    }
+    return total;
+  }
+
+ public:
+  /** @brief Construct a new SyscallCounter object */
+  SyscallCounter() {
+    if (open_perf_()) return;
+    u_long first = read_proc_io_();
+    sample_cost_ = read_proc_io_() - first;
+  }
+
+  /** @brief Destroy the SyscallCounter object */
+  ~SyscallCounter() {
+    if (perf_fd_ != -1) ::close(perf_fd_);
+  }
+
+  SyscallCounter(const SyscallCounter &) = delete;
+  SyscallCounter &operator=(const SyscallCounter &) = delete;
+
+  /**
+   * @brief Returns whether or not every syscall is counted
+   *
+   * @return true if counting through perf
+   * @return false if counting read and write syscalls only
+   */
+  bool is_exact() const { return perf_fd_ != -1; }
+
+  /**
+   * @brief Returns the current count
+   *
+   * @return u_long
+   */
+  u_long read() const {
+    if (perf_fd_ == -1) return read_proc_io_();
+    uint64_t count = 0;
+    if (::read(perf_fd_, &count, sizeof(count)) != sizeof(count)) return 0;
+    return u_long(count);
+  }
+
+  /**
+   * @brief Returns the syscalls between two counts, minus the cost of
+   * reading the counter
+   *
+   * @param begin Count before the measured code
+   * @param end Count after the measured code
+   * @return u_long
+   */
+  u_long between(u_long begin, u_long end) const {
+    // One perf read() lands after the begin count
+    u_long cost = is_exact() ? 1 : sample_cost_;
+    return end - begin > cost ? end - begin - cost : 0;
+  }
+};
+
+/** @brief Benchmark settings */
+struct Options {
+  /** @brief Parent directory of the fixture (tmpfs preferred if empty) */
+  std::string dir;
+  /** @brief Number of fake cpus */
+  size_t cpus = 4;
+  /** @brief Number of fake thermal zones */
+  size_t zones = 2;
+  /** @brief Fake process counts to measure */
+  std::vector<size_t> procs = {1000, 10000, 50000};
+  /** @brief Measured ticks per mode */
+  size_t ticks = 100;
+  /** @brief Modes to measure: throttle, sigstop, combined, or all */
+  std::string mode = "all";
+  /** @brief Value of scan_threads */
+  uint scan_threads = 1;
+  /** @brief Whether or not to leave the fixture behind */
+  bool keep = false;
+};
+
+/** @brief Measurements of one mode */
+struct Result {
+  /** @brief Latency of each tick (in microseconds) */
+  std::vector<double> latencies;
+  /** @brief Syscalls made across all ticks */
+  u_long syscalls = 0;
+  /** @brief Allocations made across all ticks */
+  u_long allocs = 0;
+};
+
+/**
+ * @brief Parses the command line
+ *
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Options
+ * @throw templimiter::error::ArgumentError if an argument is not understood
+ */
+Options parse_options(int argc, char *argv[]) {
+  Options opts;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--keep") {
+      opts.keep = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      throw error::ArgumentError(arg, "value", "", "Missing value.");
+    }
+    std::string value = argv[++i];
+    if (arg == "--dir") {
+      opts.dir = value;
+    } else if (arg == "--cpus") {
+      opts.cpus = tools::convert<size_t>(value);
+    } else if (arg == "--zones") {
+      opts.zones = tools::convert<size_t>(value);
+    } else if (arg == "--procs") {
+      opts.procs = tools::convert<size_t>(tools::split(value, ','));
+    } else if (arg == "--ticks") {
+      opts.ticks = tools::convert<size_t>(value);
+    } else if (arg == "--scan-threads") {
+      opts.scan_threads = tools::convert<uint>(value);
+    } else if (arg == "--mode" && (value == "throttle" || value == "sigstop" ||
+                                   value == "combined" || value == "all")) {
+      opts.mode = value;
+    } else {
+      throw error::ArgumentError(arg, "", value, "Unknown argument.");
+    }
+  }
+  if (opts.cpus == 0 || opts.zones == 0 || opts.ticks == 0) {
+    throw error::ArgumentError("--cpus, --zones, --ticks", "positive integer",
+                               "0");
+  }
+  return opts;
+}
+
+/**
+ * @brief Returns the zone temperature of a tick, sweeping every threshold
+ *
+ * @param tick Tick number
+ * @return u_long
+ */
+u_long temp_of_tick(size_t tick) {
+  u_long phase = tick % (2 * TEMP_RISE_TICKS);
+  u_long steps = phase < TEMP_RISE_TICKS ? phase : 2 * TEMP_RISE_TICKS - phase;
+  return TEMP_LOW + steps * TEMP_STEP;
+}
+
+/**
+ * @brief Drives a Monitor through the fixture and measures every tick
+ *
+ * @param fixture Fake sysfs/procfs
+ * @param counter Syscall counter
+ * @param name Mode name
+ * @param use_throttle Whether or not throttle mode is enabled
+ * @param use_SIGSTOP Whether or not SIGSTOP mode is enabled
+ * @param opts Benchmark settings
+ * @return Result
+ */
+Result run_mode(Fixture &fixture, const SyscallCounter &counter,
+                const std::string &name, bool use_throttle, bool use_SIGSTOP,
+                const Options &opts) {
+  fixture.reset_frequencies();
+  fixture.set_temp(TEMP_LOW);
+  std::string path = fixture.write_config(name + ".conf", use_throttle,
+                                          use_SIGSTOP, opts.scan_threads);
+
+  // Keep the default tag notices out of the report
+  std::streambuf *clog_buf = std::clog.rdbuf(nullptr);
+  auto cfg = std::make_shared<daemon::Config>(path);
+  std::clog.rdbuf(clog_buf);
+  std::clog.clear();
+  auto out = std::make_shared<daemon::Logger>(cfg, false);
+  daemon::Monitor monitor(cfg, out);
+
+  // The first ticks only build the process table
+  for (size_t i = 0; i < 2; i++) {
+    fixture.advance();
+    monitor.tick();
+  }
+
+  Result result;
+  result.latencies.reserve(opts.ticks);
+  for (size_t i = 0; i < opts.ticks; i++) {
+    fixture.set_temp(temp_of_tick(i));
+    fixture.advance();
+    u_long allocs_begin = alloc_count.load(std::memory_order_relaxed);
+    u_long sys_begin = counter.read();
+    auto begin = std::chrono::steady_clock::now();
+    monitor.tick();
+    auto end = std::chrono::steady_clock::now();
+    u_long sys_end = counter.read();
+    u_long allocs_end = alloc_count.load(std::memory_order_relaxed);
+    result.latencies.push_back(
+        std::chrono::duration<double, std::micro>(end - begin).count());
+    result.syscalls += counter.between(sys_begin, sys_end);
+    result.allocs += allocs_end - allocs_begin;
+  }
+  return result;
+}
+
+/**
+ * @brief Returns a percentile of sorted values
+ *
+ * @param sorted Values in ascending order
+ * @param pct Percentile, from 0 to 1
+ * @return double
+ */
+double percentile(const std::vector<double> &sorted, double pct) {
+  size_t i = size_t(pct * double(sorted.size()));
+  return sorted[std::min(i, sorted.size() - 1)];
+}
+
+/**
+ * @brief Prints one report row
+ *
+ * @param name Mode name
+ * @param procs Number of fake processes
+ * @param result Measurements
+ */
+void print_row(const std::string &name, size_t procs, Result result) {
+  std::vector<double> &lat = result.latencies;
+  std::sort(lat.begin(), lat.end());
+  double mean = 0;
+  for (double v : lat) mean += v;
+  mean /= double(lat.size());
+  double n = double(lat.size());
+  std::cout << std::left << std::setw(10) << name << std::right
+            << std::setw(8) << procs << std::fixed << std::setprecision(1)
+            << std::setw(11) << mean << std::setw(11) << percentile(lat, 0.5)
+            << std::setw(11) << percentile(lat, 0.99) << std::setw(11)
+            << lat.back() << std::setw(12) << double(result.syscalls) / n
+            << std::setw(12) << double(result.allocs) / n << std::endl;
+}
+
+}  // namespace
+
+}  // namespace bench
+
+}  // namespace templimiter
+
+/**
+ * @brief Main function for the tick benchmark
+ *
+ * @return int
+ */
+int main(int argc, char *argv[]) {
+  using namespace templimiter;
+
+  try {
+    bench::Options opts = bench::parse_options(argc, argv);
+    bench::SyscallCounter counter;
+    struct Mode {
+      const char *name;
+      bool use_throttle;
+      bool use_SIGSTOP;
+    };
+    const Mode modes[] = {{"throttle", true, false},
+                          {"sigstop", false, true},
+                          {"combined", true, true}};
+
+    std::cout << "templimiter tick benchmark: " << opts.cpus << " cpus, "
+              << opts.zones << " zones, " << opts.ticks << " ticks per mode, "
+              << opts.scan_threads << " scan threads" << std::endl
+              << "syscalls: "
+              << (counter.is_exact() ? "all (perf raw_syscalls)"
+                                     : "read/write only (/proc/self/io)")
+              << "; allocations: operator new calls" << std::endl
+              << std::left << std::setw(10) << "mode" << std::right
+              << std::setw(8) << "procs" << std::setw(11) << "mean_us"
+              << std::setw(11) << "p50_us" << std::setw(11) << "p99_us"
+              << std::setw(11) << "max_us" << std::setw(12) << "sys/tick"
+              << std::setw(12) << "alloc/tick" << std::endl;
+    for (size_t procs : opts.procs) {
+      bench::Fixture fixture(opts.dir, opts.cpus, opts.zones, procs,
+                             opts.keep);
+      for (const Mode &mode : modes) {
+        if (opts.mode != "all" && opts.mode != mode.name) continue;
+        bench::print_row(mode.name, procs,
+                         bench::run_mode(fixture, counter, mode.name,
+                                         mode.use_throttle, mode.use_SIGSTOP,
+                                         opts));
+      }
+      if (opts.keep) std::cout << "fixture: " << fixture.root() << std::endl;
+    }
+  } catch (const error::Error &e) {
+    io::err(e.what());
+    return 1;
+  }
+  return 0;
+}
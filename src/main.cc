@@ -21,19 +21,26 @@
  * the cpu, and sending SIGSTOP and SIGCONT signals.
  * @version 0.1.2
  * @date created 2019-01-31
- * @date modified 2019-02-15
+ * @date modified 2026-10-14
  * @copyright Copyright (c) 2019 Justin Collier
  */
 
 #include <cstring>
+#include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <string>
 
+#include "templimiter/daemon/cgroup-limiter.h"
+#include "templimiter/daemon/config-reloader.h"
 #include "templimiter/daemon/config.h"
+#include "templimiter/daemon/isolation.h"
 #include "templimiter/daemon/logger.h"
 #include "templimiter/daemon/monitor.h"
-#include "templimiter/daemon/pid.h"
+#include "templimiter/daemon/rapl-actuator.h"
+#include "templimiter/daemon/runner.h"
+#include "templimiter/daemon/telemetry.h"
+#include "templimiter/error/config-error.h"
 #include "templimiter/error/error.h"
 #include "templimiter/io/operations.h"
 
@@ -41,6 +48,31 @@
 #define TEMPLIMITER_CONFIG_PATH "/usr/local/etc/conf.d/templimiter.conf"
 #endif
 
+namespace {
+
+/**
+ * @brief Releases the limits that a daemon killed before its destructors ran
+ * may have left behind; run from ExecStopPost
+ *
+ * @param cfg Shared pointer to the execution configuration
+ * @param out Shared pointer to the execution logger
+ */
+void release_stale_limits(
+    const std::shared_ptr<templimiter::daemon::Config> &cfg,
+    const std::shared_ptr<templimiter::daemon::Logger> &out) {
+  using namespace templimiter;
+  out->log("Releasing the limits left behind by a stopped templimiter.");
+  if (cfg->use_SIGSTOP() && cfg->use_cgroup()) {
+    daemon::CgroupLimiter(cfg, out).release_stale();
+  }
+  if (cfg->use_throttle() && cfg->use_rapl()) {
+    // Destroying it restores the power limits kept in rapl_state_path
+    daemon::RaplActuator actuator(cfg);
+  }
+}
+
+}  // namespace
+
 /**
  * @brief Main function for templimiter daemon
  *
@@ -49,7 +81,13 @@
 int main(int argc, char *argv[]) {
   using namespace templimiter;
 
-  if (argc > 2) {
+  bool is_dump_csv =
+      argc > 1 && strncmp(argv[1], "--dump-telemetry", 17) == 0;
+  bool is_dump_json =
+      argc > 1 && strncmp(argv[1], "--dump-telemetry-json", 22) == 0;
+
+  // The telemetry dump flags accept an optional file path
+  if (argc > 3 || (argc > 2 && !is_dump_csv && !is_dump_json)) {
     io::err(
         "Multiple arguments supplied to templimiter. Only the first will be "
         "accepted.");
@@ -76,10 +114,31 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
+  // Check for --dump-telemetry and --dump-telemetry-json flags
+  if (is_dump_csv || is_dump_json) {
+    try {
+      std::string path =
+          argc > 2
+              ? std::string(argv[2])
+              : daemon::Config(TEMPLIMITER_CONFIG_PATH).telemetry_file_path();
+      if (path.empty()) {
+        throw error::ConfigError("telemetry_file_path", "",
+                                 "No telemetry file path is configured or "
+                                 "provided.");
+      }
+      daemon::Telemetry::dump(path, is_dump_json, std::cout);
+    } catch (const error::Error &e) {
+      io::err(e.what());
+      return 1;
+    }
+    return 0;
+  }
+
   // Try/catch initialization procedures; logs go to stdout
   try {
     bool is_debug_mode = argc > 1 && (strncmp(argv[1], "-d", 3) == 0 ||
                                       strncmp(argv[1], "--debug", 8) == 0);
+    bool is_release = argc > 1 && strncmp(argv[1], "--release", 10) == 0;
 
     std::shared_ptr<daemon::Config> cfg =
         std::make_shared<daemon::Config>(TEMPLIMITER_CONFIG_PATH);
@@ -88,7 +147,21 @@ int main(int argc, char *argv[]) {
 
     // Try/catch daemon::Monitor; logs go to established logger
     try {
-      const daemon::Monitor mon(cfg, out);
+      // Check for --release flag
+      if (is_release) {
+        release_stale_limits(cfg, out);
+        return 0;
+      }
+
+      // Shield the control loop from the workload before it allocates
+      daemon::isolate_control_thread(cfg, out);
+      // Returns on SIGTERM or SIGINT; destroying the monitor then continues
+      // every stopped process and thaws every limited cgroup
+      daemon::Runner(std::make_shared<daemon::Monitor>(cfg, out),
+                     std::make_shared<daemon::ConfigReloader>(
+                         cfg, out, TEMPLIMITER_CONFIG_PATH))
+          .run();
+      out->log("Received a termination signal. Exited cleanly.");
     } catch (const error::Error &e) {
       out->err(e.what());
       return 1;
@@ -0,0 +1,495 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file cgroup-limiter.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::CgroupLimiter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/cgroup-limiter.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+#include "templimiter/error/error.h"
+#include "templimiter/io/file.h"
+#include "templimiter/io/operations.h"
+#include "templimiter/tools/string.h"
+#include "templimiter/tools/type-convert.h"
+#include "templimiter/tools/vector.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+constexpr u_long CgroupLimiter::CPU_MAX_PERIOD_;
+
+namespace {
+
+/** @brief Size of the cpu.stat buffer */
+constexpr size_t READ_BUF_SIZE = 1024;
+
+/** @brief Key of the cpu.stat line holding the total cpu usage */
+constexpr std::string_view USAGE_KEY = "usage_usec ";
+
+/** @brief First line of the state file; changes with its format */
+const std::string STATE_HEADER = "templimiter-cgroup 1";
+
+}  // namespace
+
+void CgroupLimiter::load_own_cgroup_() {
+  // The cgroup v2 entry has the form "0::<path>"
+  io::File<std::string> self_cgroup(PROC_SELF_CGROUP_);
+  for (const auto &line : self_cgroup.read()) {
+    if (line.compare(0, 3, "0::") == 0) {
+      own_cgroup_ = line.substr(3);
+      if (own_cgroup_ == "/") own_cgroup_.clear();
+      return;
+    }
+  }
+}
+
+std::unordered_map<std::string, std::string> CgroupLimiter::load_state_()
+    const {
+  std::ifstream in(state_path_);
+  std::string line;
+  if (!std::getline(in, line) || line != STATE_HEADER) return {};
+  std::unordered_map<std::string, std::string> originals;
+  // One "path<tab>original" line per cgroup; originals hold no tabs
+  while (std::getline(in, line)) {
+    size_t sep = line.rfind('\t');
+    if (sep == std::string::npos || sep == 0) return {};
+    originals[line.substr(0, sep)] = line.substr(sep + 1);
+  }
+  return originals;
+}
+
+bool CgroupLimiter::store_state_() const {
+  if (state_path_ == "") return true;
+  if (originals_.empty()) {
+    return std::remove(state_path_.c_str()) == 0 || errno == ENOENT;
+  }
+  std::ostringstream out;
+  out << STATE_HEADER << '\n';
+  for (const auto &entry : originals_) {
+    out << entry.first << '\t' << entry.second << '\n';
+  }
+  return io::replace_file(state_path_, out.str());
+}
+
+size_t CgroupLimiter::restore_all_() {
+  size_t restored = 0;
+  for (auto it = originals_.begin(); it != originals_.end();) {
+    int error = write_value_(it->first, it->second);
+    if (error == 0) restored++;
+    if (error == 0 || error == ENOENT || error == ENODEV) {
+      it = originals_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // Whatever could not be written is left for --release
+  store_state_();
+  return restored;
+}
+
+bool CgroupLimiter::is_whitelisted_(const std::string &rel) const {
+  if (rel == own_cgroup_) return true;
+  for (const auto &pattern : cfg_->whitelist_cgroup()) {
+    if (tools::matches_pattern(pattern, rel)) return true;
+  }
+  return false;
+}
+
+void CgroupLimiter::scan_dir_(const std::string &rel) {
+  DIR *dir = ::opendir((root_ + rel).c_str());
+  if (dir == nullptr) return;
+  bool has_children = false;
+  while (const dirent *ent = ::readdir(dir)) {
+    if (ent->d_type != DT_DIR || ent->d_name[0] == '.') continue;
+    has_children = true;
+    scan_dir_(rel + "/" + ent->d_name);
+  }
+  ::closedir(dir);
+  // Under cgroup v2 only leaves hold processes; the root cannot be limited
+  if (!has_children && !rel.empty()) measure_(rel);
+}
+
+void CgroupLimiter::measure_(const std::string &rel) {
+  int fd = ::open((root_ + rel + "/cpu.stat").c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) return;
+  ssize_t n;
+  do {
+    n = ::read(fd, read_buf_.data(), read_buf_.size());
+  } while (n == -1 && errno == EINTR);
+  ::close(fd);
+  if (n <= 0) return;
+  scanned_++;
+
+  std::string_view stat(read_buf_.data(), size_t(n));
+  size_t key = stat.find(USAGE_KEY);
+  if (key == std::string_view::npos) return;
+  const char *begin = stat.data() + key + USAGE_KEY.size();
+  u_long usage = 0;
+  if (std::from_chars(begin, stat.data() + stat.size(), usage).ec !=
+      std::errc()) {
+    return;
+  }
+
+  auto found = cgroups_.find(rel);
+  if (found == cgroups_.end()) {
+    Cgroup cgroup;
+    cgroup.usage_prev = usage;
+    cgroup.seen = scan_generation_;
+    cgroup.is_whitelisted = is_whitelisted_(rel);
+    cgroups_.emplace(rel, cgroup);
+  } else {
+    Cgroup &cgroup = found->second;
+    cgroup.usage_delta =
+        usage >= cgroup.usage_prev ? usage - cgroup.usage_prev : 0;
+    cgroup.usage_prev = usage;
+    cgroup.seen = scan_generation_;
+    cgroup.is_ready = true;
+    // Others may have lifted their own limit since
+    cgroup.is_capped = false;
+  }
+}
+
+std::string CgroupLimiter::interface_path_(const std::string &rel) const {
+  return root_ + rel +
+         (cfg_->use_cgroup_cpu_max() ? "/cpu.max" : "/cgroup.freeze");
+}
+
+u_long CgroupLimiter::quota_(const Cgroup &cgroup, uint level) const {
+  u_long quota = cgroup.start_quota;
+  for (uint i = 0; i < level; i++) {
+    quota = quota / 2 > floor_quota_ ? quota / 2 : floor_quota_;
+  }
+  return quota;
+}
+
+int CgroupLimiter::load_original_(const std::string &rel, Cgroup &cgroup,
+                                  std::string &original) {
+  auto kept = originals_.find(rel);
+  if (kept != originals_.end()) {
+    // A previous run limited it, so the file holds that run's limit
+    original = kept->second;
+  } else {
+    int fd = ::open(interface_path_(rel).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return errno;
+    ssize_t n;
+    do {
+      n = ::read(fd, read_buf_.data(), read_buf_.size());
+    } while (n == -1 && errno == EINTR);
+    int read_errno = errno;
+    ::close(fd);
+    if (n == -1) return read_errno;
+    original.assign(read_buf_.data(), size_t(n));
+    while (!original.empty() && original.back() == '\n') original.pop_back();
+  }
+
+  if (!cfg_->use_cgroup_cpu_max()) {
+    // A cgroup frozen by others is left to them
+    if (original != "0" && original != "1") return EINVAL;
+    cgroup.max_level = original == "0" ? 1 : 0;
+    return 0;
+  }
+  // cpu.max has the form "<quota or max> <period>"
+  size_t sep = original.find(' ');
+  if (sep == std::string::npos) return EINVAL;
+  cgroup.start_quota = full_quota_;
+  if (original.compare(0, sep, "max") != 0) {
+    try {
+      u_long quota = tools::convert<u_long>(original.substr(0, sep));
+      u_long period = tools::convert<u_long>(original.substr(sep + 1));
+      if (period == 0) return EINVAL;
+      // Scale the quota to CPU_MAX_PERIOD_, which every level is written in
+      quota = quota * CPU_MAX_PERIOD_ / period;
+      if (quota < cgroup.start_quota) cgroup.start_quota = quota;
+    } catch (const error::Error &) {
+      return EINVAL;
+    }
+  }
+  cgroup.max_level = 0;
+  for (u_long quota = cgroup.start_quota; quota > floor_quota_;) {
+    quota = quota / 2 > floor_quota_ ? quota / 2 : floor_quota_;
+    cgroup.max_level++;
+  }
+  return 0;
+}
+
+int CgroupLimiter::write_value_(const std::string &rel,
+                                const std::string &value) {
+  int fd = ::open(interface_path_(rel).c_str(), O_WRONLY | O_CLOEXEC);
+  if (fd == -1) return errno;
+  ssize_t n = ::write(fd, value.data(), value.size());
+  int write_errno = errno;
+  ::close(fd);
+  signals_++;
+  if (n == -1) return write_errno;
+  // A short write sets no errno
+  return n == ssize_t(value.size()) ? 0 : -1;
+}
+
+int CgroupLimiter::write_level_(const std::string &rel, const Cgroup &cgroup,
+                                uint level) {
+  std::string value;
+  if (level == 0) {
+    auto found = originals_.find(rel);
+    if (found != originals_.end()) {
+      value = found->second;
+    } else {
+      value = cfg_->use_cgroup_cpu_max()
+                  ? "max " + tools::to_string(CPU_MAX_PERIOD_)
+                  : std::string("0");
+    }
+  } else if (cfg_->use_cgroup_cpu_max()) {
+    value = tools::to_string(quota_(cgroup, level)) + " " +
+            tools::to_string(CPU_MAX_PERIOD_);
+  } else {
+    value = "1";
+  }
+  return write_value_(rel, value);
+}
+
+bool CgroupLimiter::is_limitable_(const Cgroup &cgroup) const {
+  // max_level is only known once the cgroup has been limited
+  return cgroup.is_ready && !cgroup.is_whitelisted && !cgroup.is_ignored &&
+         !cgroup.is_capped && cgroup.usage_delta > 0 &&
+         (cgroup.level == 0 || cgroup.level < cgroup.max_level);
+}
+
+bool CgroupLimiter::set_level_(const std::string &rel, Cgroup &cgroup,
+                               uint level) {
+  std::string original;
+  int error = 0;
+  bool is_recorded = false;
+  if (cgroup.level == 0 && level > 0) {
+    error = load_original_(rel, cgroup, original);
+    if (error == 0 && cgroup.max_level == 0) {
+      cgroup.is_capped = true;
+      return false;
+    }
+  }
+  if (error == 0) {
+    if (level > cgroup.max_level) level = cgroup.max_level;
+    if (cgroup.level == level) return false;
+    if (cgroup.level == 0) {
+      // Record the original before limiting, in case the daemon is killed
+      is_recorded = originals_.emplace(rel, original).second;
+      if (is_recorded && !store_state_()) {
+        originals_.erase(rel);
+        out_->err("[Warning] Could not write " + state_path_ +
+                  ". Not limiting cgroup " + rel + " from now on.");
+        cgroup.is_ignored = true;
+        return false;
+      }
+    }
+    error = write_level_(rel, cgroup, level);
+  }
+  if (error != 0) {
+    if (is_recorded) {
+      originals_.erase(rel);
+      store_state_();
+    }
+    // A cgroup that has just been removed is not worth a warning
+    if (error != ENOENT && error != ENODEV) {
+      std::string reason = error == -1 ? "short write" : std::strerror(error);
+      out_->err("[Warning] Could not limit cgroup " + rel + " (" + reason +
+                "). Ignoring it from now on.");
+      cgroup.is_ignored = true;
+    }
+    return false;
+  }
+  if (cfg_->use_cgroup_cpu_max()) {
+    if (level == 0) {
+      out_->log("Releasing cpu.max of cgroup " + rel);
+    } else {
+      out_->log("Setting cpu.max of cgroup " + rel + " to " +
+                tools::to_string(quota_(cgroup, level) * 100 /
+                                 CPU_MAX_PERIOD_) +
+                "% of a cpu");
+    }
+  } else {
+    out_->log((level == 0 ? "Thawing cgroup " : "Freezing cgroup ") + rel);
+  }
+  if (cgroup.level == 0) limited_count_++;
+  if (level == 0) {
+    originals_.erase(rel);
+    store_state_();
+    limited_count_--;
+  }
+  cgroup.level = level;
+  return true;
+}
+
+CgroupLimiter::CgroupLimiter(const std::shared_ptr<Config> &cfg,
+                             const std::shared_ptr<Logger> &out)
+    : cfg_(cfg),
+      out_(out),
+      root_(cfg->cgroup_root()),
+      state_path_(cfg->cgroup_state_path()),
+      read_buf_(READ_BUF_SIZE) {
+  load_own_cgroup_();
+  if (state_path_ != "") originals_ = load_state_();
+  if (cfg_->use_cgroup_cpu_max()) {
+    // Levels halve the quota from at most all cpus down to the floor
+    long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+    full_quota_ = CPU_MAX_PERIOD_ * u_long(cpus > 0 ? cpus : 1);
+    floor_quota_ = CPU_MAX_PERIOD_ * cfg_->cgroup_min_cpu_pct() / 100;
+    if (floor_quota_ < 1000) floor_quota_ = 1000;
+  }
+}
+
+CgroupLimiter::~CgroupLimiter() {
+  // Never leave cgroups limited behind an exiting daemon
+  restore_all_();
+}
+
+void CgroupLimiter::update() {
+  scan_generation_++;
+  scan_dir_("");
+  // Forget cgroups that were removed or are no longer leaves
+  for (auto it = cgroups_.begin(); it != cgroups_.end();) {
+    if (it->second.seen != scan_generation_) {
+      if (it->second.level > 0) {
+        write_level_(it->first, it->second, 0);
+        limited_count_--;
+      }
+      it = cgroups_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // Forget the originals of those cgroups (and of a previous run's gone ones)
+  bool is_changed = false;
+  for (auto it = originals_.begin(); it != originals_.end();) {
+    if (cgroups_.count(it->first) == 0) {
+      it = originals_.erase(it);
+      is_changed = true;
+    } else {
+      ++it;
+    }
+  }
+  if (is_changed) store_state_();
+}
+
+void CgroupLimiter::refresh_limited() { update(); }
+
+void CgroupLimiter::release_stale() {
+  size_t released = restore_all_();
+  if (!originals_.empty()) {
+    out_->err("[Warning] Could not release " +
+              tools::to_string(originals_.size()) + " cgroups. They are kept" +
+              " in " + state_path_ + ".");
+  }
+  out_->log("Released " + tools::to_string(released) + " cgroups.");
+}
+
+void CgroupLimiter::forget() {
+  if (limited_count_ > 0) return;
+  tools::free_memory(cgroups_);
+}
+
+void CgroupLimiter::reload_whitelist() {
+  for (auto &entry : cgroups_) {
+    entry.second.is_whitelisted = is_whitelisted_(entry.first);
+  }
+}
+
+bool CgroupLimiter::limit_next() {
+  while (true) {
+    std::pair<const std::string, Cgroup> *best = nullptr;
+    for (auto &entry : cgroups_) {
+      const Cgroup &v = entry.second;
+      if (!is_limitable_(v)) continue;
+      if (best == nullptr || v.usage_delta > best->second.usage_delta) {
+        best = &entry;
+      }
+    }
+    if (best == nullptr) return false;
+    Cgroup &cgroup = best->second;
+    if (set_level_(best->first, cgroup, cgroup.level + 1)) return true;
+    // Move on to the runner-up if this one turned out to be out of reach
+    if (!cgroup.is_capped && !cgroup.is_ignored) return false;
+  }
+}
+
+bool CgroupLimiter::limit_all() {
+  bool limited = false;
+  for (auto &entry : cgroups_) {
+    if (!is_limitable_(entry.second)) continue;
+    // set_level_ lowers this to the cgroup's own highest level
+    if (set_level_(entry.first, entry.second,
+                   std::numeric_limits<uint>::max())) {
+      limited = true;
+    }
+  }
+  return limited;
+}
+
+bool CgroupLimiter::release_next() {
+  std::pair<const std::string, Cgroup> *best = nullptr;
+  for (auto &entry : cgroups_) {
+    const Cgroup &v = entry.second;
+    if (v.level == 0) continue;
+    if (best == nullptr || v.usage_delta < best->second.usage_delta) {
+      best = &entry;
+    }
+  }
+  if (best == nullptr) return false;
+  return set_level_(best->first, best->second, best->second.level - 1);
+}
+
+bool CgroupLimiter::release_all() {
+  bool released = false;
+  for (auto &entry : cgroups_) {
+    if (entry.second.level == 0) continue;
+    if (set_level_(entry.first, entry.second, 0)) released = true;
+  }
+  return released;
+}
+
+size_t CgroupLimiter::limited_count() const { return limited_count_; }
+u_long CgroupLimiter::scanned() const { return scanned_; }
+u_long CgroupLimiter::signals() const { return signals_; }
+// Cgroup paths are matched against whitelist_cgroup only, once per cgroup
+u_long CgroupLimiter::whitelist_checks() const { return 0; }
+std::chrono::nanoseconds CgroupLimiter::whitelist_time() const { return {}; }
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,300 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file cgroup-limiter.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::CgroupLimiter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+#include "templimiter/daemon/process-limiter.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Limits whole cgroup v2 leaf cgroups, ranked by cpu.stat usage, by
+ * writing cgroup.freeze or by stepping their cpu.max bandwidth down
+ *
+ * Each cgroup has a limit level: 0 is its original state. In freezer mode
+ * level 1 is frozen; in cpu.max mode every level halves the quota down to
+ * the configured minimum, starting from all cpus or from the quota that the
+ * cgroup already had, whichever is lower. Releasing a cgroup writes back the
+ * value found before it was first limited, so that limits set by others
+ * (such as a systemd CPUQuota) survive. These values are kept in
+ * cgroup_state_path while the cgroups are limited, so that a daemon that was
+ * killed can still be cleaned up after, and so that a restarted one does not
+ * take its predecessor's limits as the originals.
+ */
+class CgroupLimiter : public ProcessLimiter {
+ private:
+  /** @brief State of a tracked leaf cgroup */
+  struct Cgroup {
+    /** @brief usage_usec from the previous scan */
+    u_long usage_prev = 0;
+    /** @brief usage_usec gained between the last two scans */
+    u_long usage_delta = 0;
+    /** @brief Value of scan_generation_ when the cgroup was last found */
+    u_long seen = 0;
+    /** @brief Current limit level */
+    uint level = 0;
+    /** @brief Highest limit level (known once the cgroup is limited) */
+    uint max_level = 0;
+    /** @brief cpu.max quota that the limit levels halve (cpu.max mode) */
+    u_long start_quota = 0;
+    /** @brief Whether or not usage_delta has been measured */
+    bool is_ready = false;
+    /** @brief Whether or not the cgroup may never be limited */
+    bool is_whitelisted = false;
+    /** @brief Whether or not writing a limit has failed */
+    bool is_ignored = false;
+    /** @brief Whether or not the cgroup was found limited as far as it can
+     * be (frozen, or at the lowest quota) this scan */
+    bool is_capped = false;
+  };
+
+  /** @brief cpu.max period (in microseconds) */
+  static constexpr u_long CPU_MAX_PERIOD_ = 100000;
+
+  /** @brief Location of /proc/self/cgroup used to find own_cgroup_ */
+  const std::string PROC_SELF_CGROUP_ = "/proc/self/cgroup";
+
+  /** @brief Execution configuration */
+  std::shared_ptr<Config> cfg_;
+
+  /** @brief Execution logger */
+  std::shared_ptr<Logger> out_;
+
+  /** @brief Location of the cgroup v2 hierarchy */
+  std::string root_;
+
+  /** @brief Where the original interface file contents are kept ("" for
+   * off) */
+  std::string state_path_;
+
+  /** @brief Cgroup of the running process (relative to root_) */
+  std::string own_cgroup_;
+
+  /** @brief cpu.max quota of all online cpus (cpu.max mode only) */
+  u_long full_quota_ = 0;
+
+  /** @brief Lowest cpu.max quota (cpu.max mode only) */
+  u_long floor_quota_ = 0;
+
+  /** @brief Tracked leaf cgroups, keyed by path relative to root_ */
+  std::unordered_map<std::string, Cgroup> cgroups_;
+
+  /** @brief Interface file contents of every limited cgroup from before it
+   * was limited, including those left by a previous run, keyed by path
+   * relative to root_ */
+  std::unordered_map<std::string, std::string> originals_;
+
+  /** @brief Number of completed scans */
+  u_long scan_generation_ = 0;
+
+  /** @brief Number of cgroups with a level above 0 */
+  size_t limited_count_ = 0;
+
+  /** @brief Reusable buffer for cpu.stat contents */
+  std::vector<char> read_buf_;
+
+  /** @brief Number of cpu.stat files read since construction */
+  u_long scanned_ = 0;
+
+  /** @brief Number of limit levels written since construction */
+  u_long signals_ = 0;
+
+  /** @brief Reads own_cgroup_ from PROC_SELF_CGROUP_ */
+  void load_own_cgroup_();
+
+  /**
+   * @brief Reads the originals of a previous run from state_path_
+   *
+   * @return std::unordered_map< std::string, std::string > Empty unless the
+   * whole file can be parsed
+   */
+  std::unordered_map<std::string, std::string> load_state_() const;
+
+  /**
+   * @brief Writes originals_ to state_path_, removing it if empty
+   *
+   * @return true if written (or state_path_ is "")
+   * @return false if state_path_ could not be written
+   */
+  bool store_state_() const;
+
+  /**
+   * @brief Writes back every original in originals_, forgetting the ones
+   * written (or whose cgroup no longer exists), and stores the rest
+   *
+   * @return size_t Number of cgroups written back
+   */
+  size_t restore_all_();
+
+  /**
+   * @brief Checks a cgroup against own_cgroup_ and whitelist_cgroup
+   *
+   * @param rel Path of the cgroup relative to root_
+   * @return true if the cgroup may never be limited
+   * @return false if the cgroup may be limited
+   */
+  bool is_whitelisted_(const std::string &rel) const;
+
+  /**
+   * @brief Recursively visits a cgroup directory, measuring its leaves
+   *
+   * @param rel Path of the directory relative to root_
+   */
+  void scan_dir_(const std::string &rel);
+
+  /**
+   * @brief Reads cpu.stat and updates the usage of a leaf cgroup
+   *
+   * @param rel Path of the cgroup relative to root_
+   */
+  void measure_(const std::string &rel);
+
+  /**
+   * @brief Returns the interface file (cpu.max or cgroup.freeze) of a cgroup
+   *
+   * @param rel Path of the cgroup relative to root_
+   * @return std::string
+   */
+  std::string interface_path_(const std::string &rel) const;
+
+  /**
+   * @brief Returns the cpu.max quota of a limit level
+   *
+   * @param cgroup Tracked state of the cgroup
+   * @param level Limit level above 0
+   * @return u_long
+   */
+  u_long quota_(const Cgroup &cgroup, uint level) const;
+
+  /**
+   * @brief Reads the interface file of a cgroup that is about to be limited
+   * (or takes the contents kept by a previous run) and sets its start_quota
+   * and max_level from it
+   *
+   * @param rel Path of the cgroup relative to root_
+   * @param cgroup Tracked state of the cgroup
+   * @param original Set to the contents of the interface file
+   * @return int 0 if read, the errno of a failed open or read, or EINVAL if
+   * the contents cannot be parsed
+   */
+  int load_original_(const std::string &rel, Cgroup &cgroup,
+                     std::string &original);
+
+  /**
+   * @brief Writes the interface file of a cgroup
+   *
+   * @param rel Path of the cgroup relative to root_
+   * @param value New contents
+   * @return int 0 if written, the errno of a failed open or write, or -1
+   * if the value was only partly written
+   */
+  int write_value_(const std::string &rel, const std::string &value);
+
+  /**
+   * @brief Writes the interface file of a limit level; level 0 writes back
+   * the original contents
+   *
+   * @param rel Path of the cgroup relative to root_
+   * @param cgroup Tracked state of the cgroup
+   * @param level New limit level
+   * @return int 0 if written, the errno of a failed open or write, or -1
+   * if the value was only partly written
+   */
+  int write_level_(const std::string &rel, const Cgroup &cgroup, uint level);
+
+  /**
+   * @brief Checks whether limit_next and limit_all may pick a cgroup
+   *
+   * @param cgroup Tracked state of the cgroup
+   * @return true if the cgroup may be limited further
+   * @return false if it is whitelisted, ignored, idle or already at its
+   * highest level
+   */
+  bool is_limitable_(const Cgroup &cgroup) const;
+
+  /**
+   * @brief Moves a cgroup to a new limit level and logs the change; cgroups
+   * that cannot be written are whitelisted from then on
+   *
+   * @param rel Path of the cgroup relative to root_
+   * @param cgroup Tracked state of the cgroup
+   * @param level New limit level (lowered to the cgroup's max_level)
+   * @return true if the level was changed
+   * @return false if the cgroup cannot be limited further or the write
+   * failed
+   */
+  bool set_level_(const std::string &rel, Cgroup &cgroup, uint level);
+
+ public:
+  /**
+   * @brief Construct a new CgroupLimiter object
+   *
+   * @param cfg Execution configuration
+   * @param out Execution logger
+   */
+  CgroupLimiter(const std::shared_ptr<Config> &cfg,
+                const std::shared_ptr<Logger> &out);
+
+  /** @brief Destroy the CgroupLimiter object, releasing every cgroup in
+   * originals_ */
+  ~CgroupLimiter();
+
+  CgroupLimiter(const CgroupLimiter &) = delete;
+  CgroupLimiter &operator=(const CgroupLimiter &) = delete;
+
+  /**
+   * @brief Releases every cgroup that a daemon killed without cleaning up
+   * left limited, writing back the originals kept in cgroup_state_path
+   */
+  void release_stale();
+
+  void update() override;
+  void refresh_limited() override;
+  void forget() override;
+  void reload_whitelist() override;
+  bool limit_next() override;
+  bool limit_all() override;
+  bool release_next() override;
+  bool release_all() override;
+  size_t limited_count() const override;
+  u_long scanned() const override;
+  u_long signals() const override;
+  u_long whitelist_checks() const override;
+  std::chrono::nanoseconds whitelist_time() const override;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,179 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file config-reloader.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ConfigReloader class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/config-reloader.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief Size of the inotify receive buffer */
+constexpr size_t EVENT_BUF_SIZE = 4096;
+
+/** @brief Set by the SIGHUP handler, cleared by poll */
+volatile sig_atomic_t reload_signaled = 0;
+
+/** @brief Thread that constructed the reloader and runs the control loop */
+pthread_t control_thread;
+
+/**
+ * @brief Records a SIGHUP for the next poll; a signal taken by a helper
+ * thread is passed on, so that the wait of the control thread also ends
+ * early
+ *
+ * @param sig Received signal
+ */
+void on_sighup(int sig) {
+  reload_signaled = 1;
+  if (!::pthread_equal(::pthread_self(), control_thread)) {
+    ::pthread_kill(control_thread, sig);
+  }
+}
+
+/**
+ * @brief Loads a configuration file
+ *
+ * @param path Location of the config file
+ * @param demote Whether or not to leave the inherited SCHED_FIFO policy
+ * first, so that parsing cannot compete with the control thread
+ * @return std::shared_ptr< Config >
+ */
+std::shared_ptr<Config> load_config(const std::string &path, bool demote) {
+  if (demote) {
+    sched_param param{};
+    ::sched_setscheduler(0, SCHED_OTHER, &param);
+  }
+  return std::make_shared<Config>(path);
+}
+
+}  // namespace
+
+bool ConfigReloader::open_watch_() {
+  inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ == -1) return false;
+  // Editors often replace the file, so its directory is what gets watched
+  size_t slash = config_path_.rfind('/');
+  std::string dir =
+      slash == std::string::npos ? "." : config_path_.substr(0, slash + 1);
+  config_name_ = config_path_.substr(slash + 1);
+  if (::inotify_add_watch(inotify_fd_, dir.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+    ::close(inotify_fd_);
+    inotify_fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+bool ConfigReloader::drain_watch_() {
+  bool changed = false;
+  while (true) {
+    ssize_t n = ::read(inotify_fd_, event_buf_.data(), event_buf_.size());
+    if (n == -1 && errno == EINTR) continue;
+    if (n <= 0) break;
+    for (ssize_t i = 0; i < n;) {
+      const auto *event = reinterpret_cast<inotify_event *>(&event_buf_[i]);
+      if (event->len > 0 && config_name_ == event->name) changed = true;
+      i += ssize_t(sizeof(inotify_event) + event->len);
+    }
+  }
+  return changed;
+}
+
+ConfigReloader::ConfigReloader(const std::shared_ptr<Config> &cfg,
+                               const std::shared_ptr<Logger> &out,
+                               const std::string &config_path)
+    : cfg_(cfg), out_(out), config_path_(config_path) {
+  control_thread = ::pthread_self();
+  struct sigaction action {};
+  action.sa_handler = on_sighup;
+  ::sigemptyset(&action.sa_mask);
+  // Without SA_RESTART, a SIGHUP also ends an idle wait early: Monitor::wait
+  // waits in poll, which is never restarted after a signal handler
+  ::sigaction(SIGHUP, &action, nullptr);
+  if (cfg_->use_config_watch()) {
+    event_buf_.resize(EVENT_BUF_SIZE);
+    if (!open_watch_()) {
+      out_->err(
+          "[Warning] Could not watch the config file. Reloading it on SIGHUP "
+          "only.");
+    }
+  }
+}
+
+ConfigReloader::~ConfigReloader() {
+  if (inotify_fd_ != -1) ::close(inotify_fd_);
+}
+
+std::shared_ptr<Config> ConfigReloader::poll() {
+  if (reload_signaled != 0) {
+    reload_signaled = 0;
+    is_requested_ = true;
+  }
+  if (inotify_fd_ != -1 && drain_watch_()) is_requested_ = true;
+  if (!pending_.valid()) {
+    if (!is_requested_) return nullptr;
+    is_requested_ = false;
+    out_->log("Reloading the configuration from " + config_path_);
+    bool is_deadline = cfg_->sched_policy() == "deadline";
+    pending_ = std::async(
+        is_deadline ? std::launch::deferred : std::launch::async, load_config,
+        config_path_, cfg_->sched_policy() == "fifo");
+  }
+  // A deferred load runs in place on get
+  if (pending_.wait_for(std::chrono::seconds(0)) ==
+      std::future_status::timeout) {
+    return nullptr;
+  }
+  try {
+    return pending_.get();
+  } catch (const std::exception &e) {
+    out_->err("[Warning] Could not reload the configuration. Keeping the "
+              "current one.");
+    out_->err(e.what());
+  }
+  return nullptr;
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,120 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file config-reloader.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ConfigReloader class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Loads a new configuration when SIGHUP is received or, with
+ * use_config_watch, when the config file is written
+ *
+ * The file is parsed on a helper thread, so the control loop only picks the
+ * result up between iterations.
+ */
+class ConfigReloader {
+ private:
+  /** @brief Shared pointer to the execution configuration */
+  std::shared_ptr<Config> cfg_;
+
+  /** @brief Shared pointer to the execution logger */
+  std::shared_ptr<Logger> out_;
+
+  /** @brief Location of the config file */
+  std::string config_path_;
+
+  /** @brief Name of the config file within its directory */
+  std::string config_name_;
+
+  /** @brief inotify descriptor watching the config directory, or -1 */
+  int inotify_fd_ = -1;
+
+  /** @brief Receive buffer for inotify events */
+  std::vector<char> event_buf_;
+
+  /** @brief Whether or not a reload has been asked for but not started */
+  bool is_requested_ = false;
+
+  /** @brief Configuration being loaded (invalid while none is) */
+  std::future<std::shared_ptr<Config>> pending_;
+
+  /**
+   * @brief Starts watching the directory of the config file
+   *
+   * @return true if the watch was added
+   * @return false if inotify is unavailable
+   */
+  bool open_watch_();
+
+  /**
+   * @brief Reads all pending inotify events
+   *
+   * @return true if the config file was written or replaced
+   * @return false if it was not
+   */
+  bool drain_watch_();
+
+ public:
+  /**
+   * @brief Construct a new ConfigReloader object and install the SIGHUP
+   * handler
+   *
+   * @param cfg Shared pointer to the execution configuration
+   * @param out Shared pointer to the execution logger
+   * @param config_path Location of the config file
+   */
+  ConfigReloader(const std::shared_ptr<Config> &cfg,
+                 const std::shared_ptr<Logger> &out,
+                 const std::string &config_path);
+
+  /** @brief Destroy the ConfigReloader object, waiting for any load */
+  ~ConfigReloader();
+
+  ConfigReloader(const ConfigReloader &) = delete;
+  ConfigReloader &operator=(const ConfigReloader &) = delete;
+
+  /**
+   * @brief Starts a load if one has been asked for, and returns the result
+   * of a finished one; never waits unless sched_policy is deadline, where
+   * the file is parsed in place (deadline tasks cannot start threads)
+   *
+   * @return std::shared_ptr< Config > Newly loaded configuration, or null if
+   * none is ready or the new file is invalid (which is logged)
+   */
+  std::shared_ptr<Config> poll();
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
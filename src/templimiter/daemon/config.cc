@@ -19,22 +19,35 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides templimiter::daemon::Config class
  * @date created 2019-02-01
- * @date modified 2019-02-14
+ * @date modified 2026-10-14
  */
 
 #include "templimiter/daemon/config.h"
 
+#include <sched.h>
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <future>
 #include <limits>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "templimiter/daemon/frequency-ladder.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/daemon/topology-cache.h"
+#include "templimiter/daemon/whitelist.h"
 #include "templimiter/error/argument-error.h"
 #include "templimiter/error/config-error.h"
 #include "templimiter/error/error.h"
 #include "templimiter/error/internal-error.h"
 #include "templimiter/io/file-collection.h"
 #include "templimiter/io/file.h"
+#include "templimiter/io/operations.h"
 #include "templimiter/tools/string.h"
 #include "templimiter/tools/vector.h"
 
@@ -42,6 +55,127 @@ namespace templimiter {
 
 namespace daemon {
 
+namespace {
+
+/** @brief Tags that a running daemon adopts on reload */
+const std::unordered_set<std::string> RELOADABLE_TAGS = {
+    "whitelist_pid",        "whitelist_comm",        "whitelist_state",
+    "whitelist_ppid",       "whitelist_pgrp",        "whitelist_session",
+    "whitelist_tty_nr",     "whitelist_tpgid",       "whitelist_flags",
+    "whitelist_max_nice",   "whitelist_cgroup",      "use_stepwise_SIGSTOP",
+    "use_stepwise_SIGCONT", "temp_SIGSTOP",          "temp_SIGCONT",
+    "temp_SIGSTOP_prewarm", "prewarm_interval",      "prewarm_cooldown",
+    "temp_throttle",        "temp_dethrottle",       "min_sleep",
+    "max_sleep",            "thermal_event_timeout", "proc_rescan_interval",
+    "temp_target",          "pid_kp",                "pid_ki",
+    "pid_kd"};
+
+/**
+ * @brief Maps every tag of a config file to its values, ignoring comments
+ * and alignment
+ *
+ * @param lines Lines of the config file
+ * @return std::unordered_map< std::string, std::string >
+ */
+std::unordered_map<std::string, std::string> tag_values(
+    const std::vector<std::string> &lines) {
+  std::unordered_map<std::string, std::string> values;
+  for (const auto &line : lines) {
+    std::vector<std::string> spl = tools::split(line, ' ');
+    if (spl.empty() || spl[0][0] == '#') continue;
+    values[spl[0]] = tools::join(
+        tools::subvect(spl, 1, ptrdiff_t(spl.size() - 1)), " ");
+  }
+  return values;
+}
+
+/** @brief Most threads reading the cpufreq files at startup */
+constexpr size_t MAX_READ_THREADS = 8;
+
+/** @brief Fewest cpufreq files worth starting another thread for */
+constexpr size_t FILES_PER_THREAD = 32;
+
+/**
+ * @brief Finds the number of the last path component made of a prefix and
+ * digits (e.g. 12 for "cpu" in /sys/devices/system/cpu/cpu12/cpufreq)
+ *
+ * @param path Path to search
+ * @param prefix Component prefix
+ * @return long -1 if no component matches
+ */
+long component_number(const std::string &path, const std::string &prefix) {
+  const std::string marker = "/" + prefix;
+  long number = -1;
+  for (size_t pos = path.find(marker); pos != std::string::npos;
+       pos = path.find(marker, pos + 1)) {
+    size_t begin = pos + marker.size();
+    size_t end = begin;
+    while (end < path.size() &&
+           std::isdigit(static_cast<unsigned char>(path[end]))) {
+      end++;
+    }
+    if (end > begin && (end == path.size() || path[end] == '/')) {
+      number = std::strtol(path.c_str() + begin, nullptr, 10);
+    }
+  }
+  return number;
+}
+
+/** @brief Indices returned for a tag that the config does not set */
+const std::vector<size_t> NO_INDICES;
+
+/**
+ * @brief Reads the first line of a file
+ *
+ * @param path Location of the file
+ * @return std::string "" if the file does not exist or is empty
+ */
+std::string read_first_line(const std::string &path) {
+  if (!io::file_exists(path)) return "";
+  io::File<std::string> file(path);
+  const auto &lines = file.read();
+  return lines.empty() ? "" : lines[0];
+}
+
+/**
+ * @brief Reads the first line of every file, spread over up to
+ * MAX_READ_THREADS threads; each sysfs read waits on its driver, so machines
+ * with many cpus would otherwise wait on them one at a time
+ *
+ * @param paths Locations of the files
+ * @return std::vector< std::string > First line of each file ("" if absent)
+ */
+std::vector<std::string> read_first_lines(
+    const std::vector<std::string> &paths) {
+  std::vector<std::string> lines(paths.size());
+  auto read_range = [&paths, &lines](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) lines[i] = read_first_line(paths[i]);
+  };
+  size_t chunk_ct =
+      std::min(MAX_READ_THREADS,
+               (paths.size() + FILES_PER_THREAD - 1) / FILES_PER_THREAD);
+  if (chunk_ct <= 1) {
+    read_range(0, paths.size());
+    return lines;
+  }
+
+  // The caller reads the first chunk; a chunk whose thread cannot be started
+  // (as under SCHED_DEADLINE) is read by get() instead
+  size_t chunk_sz = (paths.size() + chunk_ct - 1) / chunk_ct;
+  std::vector<std::future<void>> pending;
+  for (size_t c = 1; c < chunk_ct; c++) {
+    size_t begin = std::min(paths.size(), c * chunk_sz);
+    size_t end = std::min(paths.size(), begin + chunk_sz);
+    pending.push_back(std::async(std::launch::async | std::launch::deferred,
+                                 read_range, begin, end));
+  }
+  read_range(0, chunk_sz);
+  for (auto &chunk : pending) chunk.get();
+  return lines;
+}
+
+}  // namespace
+
 void Config::assert_SIGSTOP_mode_(const std::string &value) const {
   if (!use_SIGSTOP_) {
     if (value == "") {
@@ -95,6 +229,14 @@ void Config::assert_scaling_available_frequencies_sizey_() const {
                              "Cannot find any scaling_available_frequencies "
                              "values using the provided matcher.");
   }
+  for (const auto &v : scaling_available_frequencies_) {
+    if (v.size() == 0) {
+      throw error::ConfigError("matcher_scaling_available_frequencies",
+                               matcher_scaling_available_frequencies_,
+                               "Found a scaling_available_frequencies file "
+                               "without any frequencies.");
+    }
+  }
 }
 
 void Config::assert_scaling_max_size_eq_scaling_available_(
@@ -147,18 +289,121 @@ void Config::assert_SIGSTOP_gte_SIGCONT_() const {
   }
 }
 
+void Config::assert_SIGSTOP_prewarm_valid_() const {
+  if (temp_SIGSTOP_prewarm_ == 0) return;
+  if (temp_SIGSTOP_prewarm_ > temp_SIGSTOP_) {
+    throw error::ConfigError(
+        "temp_SIGSTOP_prewarm", tools::to_string(temp_SIGSTOP_prewarm_),
+        "SIGSTOP prewarm temp must not be higher than SIGSTOP temp.");
+  }
+  if (prewarm_interval_ == 0) {
+    throw error::ConfigError("prewarm_interval", "0",
+                             "prewarm_interval must be at least 1.");
+  }
+  if (prewarm_cooldown_ == 0) {
+    throw error::ConfigError("prewarm_cooldown", "0",
+                             "prewarm_cooldown must be at least 1.");
+  }
+}
+
 void Config::assert_proc_stat_file_sizey_(size_t procstat_sz) const {
   if (procstat_sz == 0) {
     throw error::InternalError("Could not load a valid /proc/stat file.");
   }
 }
 
+void Config::assert_thermal_event_timeout_gte_min_sleep_() const {
+  if (use_thermal_events_ && thermal_event_timeout_ < min_sleep_) {
+    throw error::ConfigError(
+        "thermal_event_timeout", tools::to_string(thermal_event_timeout_),
+        "Thermal event timeout must not be lower than min_sleep.");
+  }
+}
+
+void Config::assert_max_sleep_gte_min_sleep_() const {
+  if (max_sleep_ < min_sleep_) {
+    throw error::ConfigError("max_sleep", tools::to_string(max_sleep_),
+                             "max_sleep must not be lower than min_sleep.");
+  }
+}
+
+void Config::assert_cgroup_mode_usable_() const {
+  if (!use_cgroup_) return;
+  if (!use_SIGSTOP_) {
+    throw error::ConfigError("use_cgroup", "true",
+                             "Cgroup mode requires <use_SIGSTOP>.");
+  }
+  if (!io::file_exists(cgroup_root_ + "/cgroup.controllers")) {
+    throw error::ConfigError("cgroup_root", cgroup_root_,
+                             "No cgroup v2 hierarchy found at cgroup_root.");
+  }
+  if (use_cgroup_cpu_max_ && cgroup_min_cpu_pct_ == 0) {
+    throw error::ConfigError("cgroup_min_cpu_pct", "0",
+                             "cgroup_min_cpu_pct must be at least 1.");
+  }
+}
+
+void Config::assert_proc_rescan_interval_sizey_() const {
+  if (use_proc_events_ && proc_rescan_interval_ == 0) {
+    throw error::ConfigError("proc_rescan_interval", "0",
+                             "proc_rescan_interval must be at least 1.");
+  }
+}
+
+void Config::assert_stats_interval_sizey_() const {
+  if (!stats_file_path_.empty() && stats_interval_ == 0) {
+    throw error::ConfigError("stats_interval", "0",
+                             "stats_interval must be at least 1.");
+  }
+}
+
+void Config::assert_throttle_controller_valid_() const {
+  if (throttle_controller_ != "step" && throttle_controller_ != "pid") {
+    throw error::ConfigError("throttle_controller", throttle_controller_,
+                             "Expected step or pid.");
+  }
+  const std::pair<const char *, double> gains[] = {
+      {"pid_kp", pid_kp_}, {"pid_ki", pid_ki_}, {"pid_kd", pid_kd_}};
+  for (const auto &gain : gains) {
+    if (gain.second < 0) {
+      throw error::ConfigError(gain.first, tools::to_string(gain.second),
+                               "Pid gains must not be negative.");
+    }
+  }
+}
+
+void Config::assert_throttle_actuator_valid_() const {
+  if (throttle_actuator_ != "cpufreq" && throttle_actuator_ != "rapl") {
+    throw error::ConfigError("throttle_actuator", throttle_actuator_,
+                             "Expected cpufreq or rapl.");
+  }
+  if (throttle_actuator_ != "rapl") return;
+  if (rapl_min_power_pct_ == 0 || rapl_min_power_pct_ > 100) {
+    throw error::ConfigError("rapl_min_power_pct",
+                             tools::to_string(rapl_min_power_pct_),
+                             "rapl_min_power_pct must be from 1 to 100.");
+  }
+  if (rapl_step_count_ == 0) {
+    throw error::ConfigError("rapl_step_count", "0",
+                             "rapl_step_count must be at least 1.");
+  }
+  if (io::ls(matcher_rapl_).empty()) {
+    throw error::ConfigError("matcher_rapl", matcher_rapl_,
+                             "No RAPL power limit files found.");
+  }
+}
+
 void Config::load_config_lines_(const std::string &config_path) {
   io::File<std::string> config(config_path);
   if (!config.exists()) {
     throw error::InternalError("Cannot find config file.");
   }
   config_lines_ = config.read();
+  for (size_t i = 0; i < config_lines_.size(); i++) {
+    // Index each line by the first text block; blank lines set nothing
+    std::vector<std::string> spl = tools::split(config_lines_[i], ' ');
+    if (!spl.empty()) tag_indices_[spl[0]].push_back(i);
+  }
 }
 
 void Config::get_own_pid_() {
@@ -168,22 +413,264 @@ void Config::get_own_pid_() {
   own_pid_ = tools::convert<pid_t>(self_pid);
 }
 
-std::vector<size_t> Config::indices_of_tag_(const std::string &tag) {
-  // Get the index of a tag from the previously loaded config lines
-  std::vector<size_t> found;
-  for (size_t i = 0; i < config_lines_.size(); i++) {
-    // Split the line and check the first text block for the tag
-    std::vector<std::string> spl = tools::split(config_lines_[i], ' ');
-    if (spl[0] == tag) {
-      found.push_back(i);
+const std::vector<size_t> &Config::indices_of_tag_(
+    const std::string &tag) const {
+  // Get the indices of a tag from the previously loaded config lines
+  auto found = tag_indices_.find(tag);
+  return found == tag_indices_.end() ? NO_INDICES : found->second;
+}
+
+CpufreqTopology Config::load_cpufreq_topology_() {
+  std::vector<std::string> scaling_max_paths =
+      scaling_max_freq_files_->paths();
+  CpufreqTopology topology;
+
+  // The files only change across boots, or when other files are matched
+  std::shared_ptr<TopologyCache> cache;
+  if (topology_cache_path_ != "") {
+    std::string boot_id =
+        read_first_line(proc_path_ + "/sys/kernel/random/boot_id");
+    if (boot_id == "") {
+      io::err(
+          "[Warning] Cannot find the boot id. Not caching the cpufreq "
+          "topology.");
+    } else {
+      // Stored and compared whole; a hash could differ between builds
+      std::string key = tools::join(
+          {boot_id, matcher_scaling_available_frequencies_,
+           matcher_cpuinfo_max_freq_, matcher_cpuinfo_min_freq_,
+           use_scaling_available_ ? "1" : "0",
+           tools::join(scaling_max_paths, " ")},
+          " ");
+      cache = std::make_shared<TopologyCache>(topology_cache_path_, key);
+      if (cache->load(topology) &&
+          topology.related_cpus.size() == scaling_max_paths.size()) {
+        return topology;
+      }
+      topology = CpufreqTopology();
+    }
+  }
+
+  // Gather every file first so that they are all read in one pass
+  std::vector<std::string> paths;
+  for (const auto &path : scaling_max_paths) {
+    paths.push_back(path.substr(0, path.rfind('/') + 1) + "related_cpus");
+  }
+  size_t available_begin = paths.size();
+  if (use_scaling_available_) {
+    for (const auto &path : io::ls(matcher_scaling_available_frequencies_)) {
+      paths.push_back(path);
+    }
+  }
+  size_t max_begin = paths.size();
+  size_t min_begin = max_begin;
+  if (max_begin == available_begin) {
+    // cpuinfo limits are only needed without available frequencies
+    for (const auto &path : io::ls(matcher_cpuinfo_max_freq_)) {
+      paths.push_back(path);
+    }
+    min_begin = paths.size();
+    for (const auto &path : io::ls(matcher_cpuinfo_min_freq_)) {
+      paths.push_back(path);
+    }
+  }
+  std::vector<std::string> lines = read_first_lines(paths);
+
+  topology.related_cpus.assign(lines.begin(),
+                               lines.begin() + ptrdiff_t(available_begin));
+  for (size_t i = available_begin; i < max_begin; i++) {
+    topology.available_frequencies.push_back(
+        tools::convert<u_long>(tools::split(lines[i], ' ')));
+  }
+  for (size_t i = max_begin; i < lines.size(); i++) {
+    // Empty files are skipped, leaving the size assertions to report them
+    if (lines[i] == "") continue;
+    (i < min_begin ? topology.cpuinfo_max_freqs : topology.cpuinfo_min_freqs)
+        .push_back(tools::convert<u_long>(lines[i]));
+  }
+
+  if (cache != nullptr && !cache->store(topology)) {
+    io::err("[Warning] Cannot write the cpufreq topology cache to " +
+            topology_cache_path_ + ".");
+  }
+  return topology;
+}
+
+void Config::load_cpufreq_policies_(
+    const std::vector<std::string> &related_cpus) {
+  // cpus listing the same related_cpus share one policy (and one
+  // scaling_max_freq), so they are grouped under the first one found
+  std::unordered_map<std::string, size_t> policy_of_related;
+  for (size_t i = 0; i < related_cpus.size(); i++) {
+    const std::string &related = related_cpus[i];
+    if (related == "") {
+      // Without related_cpus, the cpu is its own policy
+      cpufreq_policies_.push_back({i});
+      continue;
+    }
+    auto found = policy_of_related.find(related);
+    if (found == policy_of_related.end()) {
+      policy_of_related.emplace(related, cpufreq_policies_.size());
+      cpufreq_policies_.push_back({i});
+    } else {
+      cpufreq_policies_[found->second].push_back(i);
+    }
+  }
+}
+
+int Config::detect_zone_package_(const std::string &path) const {
+  std::string dir = path.substr(0, path.rfind('/') + 1);
+  std::string name = path.substr(dir.size());
+  if (io::file_exists(dir + "type")) {
+    io::File<std::string> type_file(dir + "type");
+    const auto &lines = type_file.read();
+    if (lines.size() > 0 && lines[0] == "x86_pkg_temp") return PKG_TEMP_ZONE_;
+    return -1;
+  }
+  // hwmon: tempN_input is described by tempN_label
+  const std::string suffix = "_input";
+  if (name.size() <= suffix.size() ||
+      name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return -1;
+  }
+  std::string label_path =
+      dir + name.substr(0, name.size() - suffix.size()) + "_label";
+  if (!io::file_exists(label_path)) return -1;
+  io::File<std::string> label_file(label_path);
+  const auto &lines = label_file.read();
+  const std::string prefix = "Package id ";
+  if (lines.size() == 0 || lines[0].compare(0, prefix.size(), prefix) != 0) {
+    return -1;
+  }
+  try {
+    return tools::convert<int>(lines[0].substr(prefix.size()));
+  } catch (const error::Error &) {
+    return -1;
+  }
+}
+
+void Config::map_pkg_temp_zones_(const std::vector<size_t> &pkg_temp_zones,
+                                 std::vector<int> &zone_packages) const {
+  if (pkg_temp_zones.empty()) return;
+  const std::vector<std::string> &zone_paths = thermal_files_->paths();
+  // Glob order is lexicographic (thermal_zone10 before thermal_zone9)
+  std::vector<std::pair<long, size_t>> numbered;
+  for (size_t z : pkg_temp_zones) {
+    numbered.emplace_back(component_number(zone_paths[z], "thermal_zone"), z);
+  }
+  std::sort(numbered.begin(), numbered.end());
+
+  std::vector<std::pair<long, int>> cpus;
+  for (const auto &path : scaling_max_freq_files_->paths()) {
+    cpus.emplace_back(component_number(path, "cpu"), detect_cpu_package_(path));
+  }
+  std::sort(cpus.begin(), cpus.end());
+  std::vector<int> packages;
+  for (const auto &cpu : cpus) {
+    if (cpu.second != -1 && std::find(packages.begin(), packages.end(),
+                                      cpu.second) == packages.end()) {
+      packages.push_back(cpu.second);
+    }
+  }
+
+  // Without cpu packages, every zone heats every cpu anyway
+  if (packages.empty()) {
+    for (size_t z : pkg_temp_zones) zone_packages[z] = -1;
+    return;
+  }
+  if (packages.size() != numbered.size() || numbered.front().first == -1) {
+    throw error::ConfigError(
+        "thermal_domain_packages", "",
+        "Found " + tools::to_string(numbered.size()) +
+            " x86_pkg_temp zones for " + tools::to_string(packages.size()) +
+            " cpu packages; cannot tell which package each zone measures. "
+            "Set it to the package of each thermal file.");
+  }
+  for (size_t i = 0; i < numbered.size(); i++) {
+    zone_packages[numbered[i].second] = packages[i];
+  }
+}
+
+int Config::detect_cpu_package_(const std::string &path) const {
+  size_t cpufreq = path.rfind("/cpufreq/");
+  if (cpufreq == std::string::npos) return -1;
+  std::string package_path =
+      path.substr(0, cpufreq) + "/topology/physical_package_id";
+  if (!io::file_exists(package_path)) return -1;
+  io::File<std::string> package_file(package_path);
+  const auto &lines = package_file.read();
+  if (lines.size() == 0) return -1;
+  try {
+    return tools::convert<int>(lines[0]);
+  } catch (const error::Error &) {
+    return -1;
+  }
+}
+
+void Config::load_thermal_domains_() {
+  size_t zone_ct = thermal_files_->size();
+  if (!use_thermal_domains_) {
+    ThermalDomain all{-1, {}, {}};
+    for (size_t i = 0; i < zone_ct; i++) all.zones.push_back(i);
+    for (size_t i = 0; i < cpufreq_policies_.size(); i++) {
+      all.policies.push_back(i);
+    }
+    thermal_domains_.push_back(all);
+    return;
+  }
+
+  // Find the package heated by each zone
+  std::vector<int> zone_packages = thermal_domain_packages_;
+  if (zone_packages.empty()) {
+    std::vector<size_t> pkg_temp_zones;
+    for (const auto &path : thermal_files_->paths()) {
+      int package = detect_zone_package_(path);
+      if (package == PKG_TEMP_ZONE_) {
+        pkg_temp_zones.push_back(zone_packages.size());
+      }
+      zone_packages.push_back(package);
+    }
+    map_pkg_temp_zones_(pkg_temp_zones, zone_packages);
+  } else if (zone_packages.size() != zone_ct) {
+    throw error::ConfigError(
+        "thermal_domain_packages", tools::to_string(zone_packages.size()),
+        "Expected one package id for each matched thermal file.");
+  }
+
+  // One domain per package of the first cpu of each policy; zones that are
+  // not package sensors heat every domain
+  std::vector<std::string> paths = scaling_max_freq_files_->paths();
+  std::unordered_map<int, size_t> domain_of_package;
+  for (size_t p = 0; p < cpufreq_policies_.size(); p++) {
+    int package = detect_cpu_package_(paths[cpufreq_policies_[p].front()]);
+    // A cpu without a known package sensor follows every zone
+    if (std::find(zone_packages.begin(), zone_packages.end(), package) ==
+        zone_packages.end()) {
+      package = -1;
+    }
+    auto found = domain_of_package.find(package);
+    if (found == domain_of_package.end()) {
+      ThermalDomain domain{package, {}, {p}};
+      for (size_t z = 0; z < zone_ct; z++) {
+        if (package == -1 || zone_packages[z] == -1 ||
+            zone_packages[z] == package) {
+          domain.zones.push_back(z);
+        }
+      }
+      domain_of_package.emplace(package, thermal_domains_.size());
+      thermal_domains_.push_back(domain);
+    } else {
+      thermal_domains_[found->second].policies.push_back(p);
     }
   }
-  return found;
 }
 
 void Config::load_config_values_() {
   // Load each tag using load_from_tag_ and hard-coded default value as fallback
   log_file_path_ = load_from_tag_<std::string>("log_file_path", log_file_path_);
+  use_async_log_ = load_from_tag_<bool>("use_async_log", use_async_log_);
+  log_milliseconds_ =
+      load_from_tag_<bool>("log_milliseconds", log_milliseconds_);
   whitelist_pid_ = load_from_tag_<pid_t>("whitelist_pid", whitelist_pid_);
   // whitelist own pid
   whitelist_pid_.push_back(own_pid_);
@@ -201,6 +688,8 @@ void Config::load_config_values_() {
   whitelist_flags_ = load_from_tag_<uint>("whitelist_flags", whitelist_flags_);
   whitelist_max_nice_ =
       load_from_tag_<long>("whitelist_max_nice", whitelist_max_nice_);
+  whitelist_cgroup_ =
+      load_from_tag_<std::string>("whitelist_cgroup", whitelist_cgroup_);
   matcher_thermal_ =
       load_from_tag_<std::string>("matcher_thermal", matcher_thermal_);
   matcher_scaling_max_freq_ = load_from_tag_<std::string>(
@@ -222,28 +711,163 @@ void Config::load_config_values_() {
       load_from_tag_<bool>("use_stepwise_SIGCONT", use_stepwise_SIGCONT_);
   temp_SIGSTOP_ = load_from_tag_<u_long>("temp_SIGSTOP", temp_SIGSTOP_);
   temp_SIGCONT_ = load_from_tag_<u_long>("temp_SIGCONT", temp_SIGCONT_);
+  temp_SIGSTOP_prewarm_ =
+      load_from_tag_<u_long>("temp_SIGSTOP_prewarm", temp_SIGSTOP_prewarm_);
+  prewarm_interval_ =
+      load_from_tag_<uint>("prewarm_interval", prewarm_interval_);
+  prewarm_cooldown_ =
+      load_from_tag_<uint>("prewarm_cooldown", prewarm_cooldown_);
   temp_throttle_ = load_from_tag_<u_long>("temp_throttle", temp_throttle_);
   temp_dethrottle_ =
       load_from_tag_<u_long>("temp_dethrottle", temp_dethrottle_);
   min_sleep_ = load_from_tag_<uint>("min_sleep", min_sleep_);
+  // Without a max_sleep, keep the fixed min_sleep interval
+  max_sleep_ = load_from_tag_<uint>("max_sleep", min_sleep_);
+  use_thermal_events_ =
+      load_from_tag_<bool>("use_thermal_events", use_thermal_events_);
+  thermal_event_timeout_ =
+      load_from_tag_<uint>("thermal_event_timeout", thermal_event_timeout_);
+  telemetry_file_path_ =
+      load_from_tag_<std::string>("telemetry_file_path", telemetry_file_path_);
+  telemetry_size_ = load_from_tag_<u_long>("telemetry_size", telemetry_size_);
+  stats_file_path_ =
+      load_from_tag_<std::string>("stats_file_path", stats_file_path_);
+  stats_interval_ = load_from_tag_<uint>("stats_interval", stats_interval_);
+  use_cgroup_ = load_from_tag_<bool>("use_cgroup", use_cgroup_);
+  cgroup_root_ = load_from_tag_<std::string>("cgroup_root", cgroup_root_);
+  use_cgroup_cpu_max_ =
+      load_from_tag_<bool>("use_cgroup_cpu_max", use_cgroup_cpu_max_);
+  cgroup_min_cpu_pct_ =
+      load_from_tag_<uint>("cgroup_min_cpu_pct", cgroup_min_cpu_pct_);
+  cgroup_state_path_ =
+      load_from_tag_<std::string>("cgroup_state_path", cgroup_state_path_);
+  use_proc_events_ = load_from_tag_<bool>("use_proc_events", use_proc_events_);
+  proc_rescan_interval_ =
+      load_from_tag_<uint>("proc_rescan_interval", proc_rescan_interval_);
+  proc_path_ = load_from_tag_<std::string>("proc_path", proc_path_);
+  scan_threads_ = load_from_tag_<uint>("scan_threads", scan_threads_);
+  use_thermal_domains_ =
+      load_from_tag_<bool>("use_thermal_domains", use_thermal_domains_);
+  thermal_domain_packages_ = load_from_tag_<int>("thermal_domain_packages",
+                                                 thermal_domain_packages_);
+  throttle_controller_ =
+      load_from_tag_<std::string>("throttle_controller", throttle_controller_);
+  temp_target_ = load_from_tag_<u_long>("temp_target", temp_target_);
+  pid_kp_ = load_from_tag_<double>("pid_kp", pid_kp_);
+  pid_ki_ = load_from_tag_<double>("pid_ki", pid_ki_);
+  pid_kd_ = load_from_tag_<double>("pid_kd", pid_kd_);
+  throttle_actuator_ =
+      load_from_tag_<std::string>("throttle_actuator", throttle_actuator_);
+  matcher_rapl_ = load_from_tag_<std::string>("matcher_rapl", matcher_rapl_);
+  rapl_min_power_pct_ =
+      load_from_tag_<uint>("rapl_min_power_pct", rapl_min_power_pct_);
+  rapl_step_count_ = load_from_tag_<uint>("rapl_step_count", rapl_step_count_);
+  rapl_state_path_ =
+      load_from_tag_<std::string>("rapl_state_path", rapl_state_path_);
+  sched_policy_ = load_from_tag_<std::string>("sched_policy", sched_policy_);
+  sched_priority_ = load_from_tag_<uint>("sched_priority", sched_priority_);
+  sched_runtime_ = load_from_tag_<uint>("sched_runtime", sched_runtime_);
+  sched_period_ = load_from_tag_<uint>("sched_period", sched_period_);
+  cpu_affinity_ = load_from_tag_<int>("cpu_affinity", cpu_affinity_);
+  use_mlockall_ = load_from_tag_<bool>("use_mlockall", use_mlockall_);
+  mlock_prefault_size_ =
+      load_from_tag_<u_long>("mlock_prefault_size", mlock_prefault_size_);
+  use_config_watch_ =
+      load_from_tag_<bool>("use_config_watch", use_config_watch_);
+  topology_cache_path_ =
+      load_from_tag_<std::string>("topology_cache_path", topology_cache_path_);
+}
+
+void Config::assert_sched_valid_() const {
+  if (sched_policy_ == "fifo") {
+    int max_priority = ::sched_get_priority_max(SCHED_FIFO);
+    if (sched_priority_ < 1 || int(sched_priority_) > max_priority) {
+      throw error::ConfigError(
+          "sched_priority", tools::to_string(sched_priority_),
+          "sched_priority must be from 1 to " +
+              tools::to_string(max_priority) + ".");
+    }
+  } else if (sched_policy_ == "deadline") {
+    if (sched_runtime_ == 0 || sched_runtime_ > sched_period_) {
+      throw error::ConfigError(
+          "sched_runtime", tools::to_string(sched_runtime_),
+          "sched_runtime must be from 1 to sched_period.");
+    }
+    if (!cpu_affinity_.empty()) {
+      // The kernel admits deadline tasks only across their whole root domain
+      throw error::ConfigError("cpu_affinity",
+                               tools::to_string(cpu_affinity_.size()),
+                               "cpu_affinity cannot be used with the deadline "
+                               "sched_policy.");
+    }
+  } else if (sched_policy_ != "other") {
+    throw error::ConfigError("sched_policy", sched_policy_,
+                             "Expected other, fifo, or deadline.");
+  }
+  for (int cpu : cpu_affinity_) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      throw error::ConfigError("cpu_affinity", tools::to_string(cpu),
+                               "Expected a cpu number.");
+    }
+  }
+}
+
+void Config::assert_scan_threads_valid_() const {
+  if (scan_threads_ == 0) {
+    throw error::ConfigError("scan_threads", "0",
+                             "scan_threads must be at least 1.");
+  }
+  if (scan_threads_ > 1 && sched_policy_ == "deadline") {
+    // Deadline tasks may not create threads
+    throw error::ConfigError(
+        "scan_threads", tools::to_string(scan_threads_),
+        "scan_threads cannot be above 1 with the deadline sched_policy.");
+  }
 }
 
 void Config::set_and_assert_config_() {
   // Ensure at least one mode is selected
   assert_any_mode_();
 
-  // Load thermal files
+  // Ensure idle waits are never shorter than regular waits
+  assert_max_sleep_gte_min_sleep_();
+  assert_thermal_event_timeout_gte_min_sleep_();
+
+  // Ensure cgroup mode has what it needs
+  assert_cgroup_mode_usable_();
+  assert_proc_rescan_interval_sizey_();
+  assert_stats_interval_sizey_();
+
+  // Ensure the control thread can be scheduled as configured
+  assert_sched_valid_();
+
+  // Load thermal files; these are read every iteration, so keep them open
   thermal_files_ =
-      std::make_shared<io::FileCollection<u_long>>(matcher_thermal_);
+      std::make_shared<io::FileCollection<u_long>>(matcher_thermal_, true);
+
+  if (use_SIGSTOP_) {
+    // Ensure the process table can be scanned as configured
+    assert_scan_threads_valid_();
+
+    // Compile the whitelist once; it is checked for every process
+    whitelist_ = Whitelist(whitelist_pid_, whitelist_comm_, whitelist_state_,
+                           whitelist_ppid_, whitelist_pgrp_, whitelist_session_,
+                           whitelist_tty_nr_, whitelist_tpgid_,
+                           whitelist_flags_, whitelist_max_nice_);
+  }
 
   if (use_throttle_) {
     // If throttle mode is selected
     // Ensure throttle temp is gte dethrottle temp
     assert_throttle_gte_dethrottle_();
 
-    // Load cur cpu freq files
-    scaling_max_freq_files_ =
-        std::make_shared<io::FileCollection<u_long>>(matcher_scaling_max_freq_);
+    // Ensure the throttle controller can be built
+    assert_throttle_controller_valid_();
+    assert_throttle_actuator_valid_();
+
+    // Load cur cpu freq files; these are read every iteration as well
+    scaling_max_freq_files_ = std::make_shared<io::FileCollection<u_long>>(
+        matcher_scaling_max_freq_, true);
 
     // Load scaling_max_freq file size for configuration assertions
     size_t scalemax_sz = scaling_max_freq_files_->read().size();
@@ -251,40 +875,25 @@ void Config::set_and_assert_config_() {
     // Ensure cur cpu freq files are found
     assert_scale_max_freq_files_sizey_(scalemax_sz);
 
-    std::shared_ptr<io::FileCollection<std::string>> test_scaling_files;
+    // Read the cpufreq files that stay fixed until the next boot
+    CpufreqTopology topology = load_cpufreq_topology_();
 
-    // Test for scaling directory before allowing it to be enabled
-    if (use_scaling_available_) {
-      try {
-        test_scaling_files = std::make_shared<io::FileCollection<std::string>>(
-            matcher_scaling_available_frequencies_);
-      } catch (const error::Error &e) {
-        // Disable if expected error occurs, otherwise throw if unexpected error
-        if (e.name() == "ArgumentError") {
-          // Warn the user
-          io::err(
-              "[Warning] Scaling available frequencies file not found! "
-              "Disabling scaling.");
-          use_scaling_available_ = false;
-        } else {
-          throw;
-        }
-      }
+    // Group cpus that share a cpufreq policy
+    load_cpufreq_policies_(topology.related_cpus);
+
+    // Test for scaling files before allowing scaling to be enabled
+    if (use_scaling_available_ && topology.available_frequencies.empty()) {
+      // Warn the user
+      io::err(
+          "[Warning] Scaling available frequencies file not found! "
+          "Disabling scaling.");
+      use_scaling_available_ = false;
     }
 
     if (use_scaling_available_) {
       // If using frequency scaling
-      // Load available frequencies
-      scaling_available_frequencies_files_ = test_scaling_files;
-
-      // Create available frequencies matrix
-      std::vector<std::string> scalemax_lines =
-          scaling_available_frequencies_files_->read();
-      for (const auto &v : scalemax_lines) {
-        std::vector<u_long> freq_vect =
-            tools::convert<u_long>(tools::split(v, ' '));
-        scaling_available_frequencies_.push_back(freq_vect);
-      }
+      // Load available frequencies matrix
+      scaling_available_frequencies_ = topology.available_frequencies;
 
       // Ensure available frequencies were found and loaded correctly
       assert_scaling_available_frequencies_sizey_();
@@ -292,21 +901,29 @@ void Config::set_and_assert_config_() {
       // Ensure cpu ct is the same for cur and available
       assert_scaling_max_size_eq_scaling_available_(scalemax_sz);
 
+      // Precompute the throttle steps of each cpu
+      for (const auto &v : scaling_available_frequencies_) {
+        frequency_ladders_.emplace_back(v);
+      }
+
     } else {
       // If using cpu min/max throttling
-      // Load min and max files
-      cpuinfo_max_freq_files_ = std::make_shared<io::FileCollection<u_long>>(
-          matcher_cpuinfo_max_freq_);
-      cpuinfo_min_freq_files_ = std::make_shared<io::FileCollection<u_long>>(
-          matcher_cpuinfo_min_freq_);
-
-      // Create min/max frequency vectors
-      cpuinfo_max_freqs_ = cpuinfo_max_freq_files_->read();
-      cpuinfo_min_freqs_ = cpuinfo_min_freq_files_->read();
+      // Load min/max frequency vectors
+      cpuinfo_max_freqs_ = topology.cpuinfo_max_freqs;
+      cpuinfo_min_freqs_ = topology.cpuinfo_min_freqs;
 
       // Ensure min and max are sizey
       assert_scaling_max_size_eq_cpu_max_and_min_(scalemax_sz);
+
+      // Precompute the two throttle steps of each cpu
+      for (size_t i = 0; i < scalemax_sz; i++) {
+        frequency_ladders_.emplace_back(
+            std::vector<u_long>{cpuinfo_min_freqs_[i], cpuinfo_max_freqs_[i]});
+      }
     }
+
+    // Decide which zones throttle which policies
+    load_thermal_domains_();
   } else {
     // If throttle mode is not selected
     // Set throttle temp to highest, just in case
@@ -319,9 +936,11 @@ void Config::set_and_assert_config_() {
     // If SIGSTOP mode is selected
     // Ensure SIGSTOP temp is gte SIGCONT temp
     assert_SIGSTOP_gte_SIGCONT_();
+    assert_SIGSTOP_prewarm_valid_();
 
     // Load CPU stats file
-    proc_stat_file_ = std::make_shared<io::File<std::string>>(PROC_STAT_);
+    proc_stat_file_ =
+        std::make_shared<io::File<std::string>>(proc_path_ + "/stat");
     // Ensure proc stat file is sizey
     assert_proc_stat_file_sizey_(proc_stat_file_->read().size());
   } else {
@@ -344,7 +963,67 @@ Config::Config(const std::string &config_path) {
   set_and_assert_config_();
 }
 
+std::vector<std::string> Config::reload(const Config &next) {
+  // Everything else was derived from the hardware at startup
+  std::vector<std::string> restart_tags;
+  auto values = tag_values(config_lines_);
+  auto next_values = tag_values(next.config_lines_);
+  for (const auto &entry : next_values) values.emplace(entry.first, "");
+  for (const auto &entry : values) {
+    if (RELOADABLE_TAGS.count(entry.first) > 0) continue;
+    auto found = next_values.find(entry.first);
+    if ((found == next_values.end() ? "" : found->second) != entry.second) {
+      restart_tags.push_back(entry.first);
+    }
+  }
+  if (!restart_tags.empty()) {
+    std::sort(restart_tags.begin(), restart_tags.end());
+    return restart_tags;
+  }
+
+  whitelist_pid_ = next.whitelist_pid_;
+  whitelist_comm_ = next.whitelist_comm_;
+  whitelist_state_ = next.whitelist_state_;
+  whitelist_ppid_ = next.whitelist_ppid_;
+  whitelist_pgrp_ = next.whitelist_pgrp_;
+  whitelist_session_ = next.whitelist_session_;
+  whitelist_tty_nr_ = next.whitelist_tty_nr_;
+  whitelist_tpgid_ = next.whitelist_tpgid_;
+  whitelist_flags_ = next.whitelist_flags_;
+  whitelist_max_nice_ = next.whitelist_max_nice_;
+  whitelist_cgroup_ = next.whitelist_cgroup_;
+  use_stepwise_SIGSTOP_ = next.use_stepwise_SIGSTOP_;
+  use_stepwise_SIGCONT_ = next.use_stepwise_SIGCONT_;
+  temp_SIGSTOP_ = next.temp_SIGSTOP_;
+  temp_SIGCONT_ = next.temp_SIGCONT_;
+  temp_SIGSTOP_prewarm_ = next.temp_SIGSTOP_prewarm_;
+  prewarm_interval_ = next.prewarm_interval_;
+  prewarm_cooldown_ = next.prewarm_cooldown_;
+  temp_throttle_ = next.temp_throttle_;
+  temp_dethrottle_ = next.temp_dethrottle_;
+  min_sleep_ = next.min_sleep_;
+  max_sleep_ = next.max_sleep_;
+  thermal_event_timeout_ = next.thermal_event_timeout_;
+  proc_rescan_interval_ = next.proc_rescan_interval_;
+  temp_target_ = next.temp_target_;
+  pid_kp_ = next.pid_kp_;
+  pid_ki_ = next.pid_ki_;
+  pid_kd_ = next.pid_kd_;
+  if (use_SIGSTOP_) {
+    // Recompiled here since next only compiles it in SIGSTOP mode
+    whitelist_.replace_rules(
+        Whitelist(whitelist_pid_, whitelist_comm_, whitelist_state_,
+                  whitelist_ppid_, whitelist_pgrp_, whitelist_session_,
+                  whitelist_tty_nr_, whitelist_tpgid_, whitelist_flags_,
+                  whitelist_max_nice_));
+  }
+  config_lines_ = next.config_lines_;
+  return restart_tags;
+}
+
 const std::string &Config::log_file_path() const { return log_file_path_; }
+bool Config::use_async_log() const { return use_async_log_; }
+bool Config::log_milliseconds() const { return log_milliseconds_; }
 const std::vector<pid_t> &Config::whitelist_pid() const {
   assert_SIGSTOP_mode_("whitelist_pid");
   return whitelist_pid_;
@@ -385,6 +1064,10 @@ long Config::whitelist_max_nice() const {
   assert_SIGSTOP_mode_("whitelist_max_nice");
   return whitelist_max_nice_;
 }
+const std::vector<std::string> &Config::whitelist_cgroup() const {
+  assert_SIGSTOP_mode_("whitelist_cgroup");
+  return whitelist_cgroup_;
+}
 bool Config::use_throttle() const { return use_throttle_; }
 bool Config::use_SIGSTOP() const { return use_SIGSTOP_; }
 bool Config::use_scaling_available() const {
@@ -407,6 +1090,18 @@ u_long Config::temp_SIGCONT() const {
   assert_SIGSTOP_mode_("temp_SIGCONT");
   return temp_SIGCONT_;
 }
+u_long Config::temp_SIGSTOP_prewarm() const {
+  assert_SIGSTOP_mode_("temp_SIGSTOP_prewarm");
+  return temp_SIGSTOP_prewarm_;
+}
+uint Config::prewarm_interval() const {
+  assert_SIGSTOP_mode_("prewarm_interval");
+  return prewarm_interval_;
+}
+uint Config::prewarm_cooldown() const {
+  assert_SIGSTOP_mode_("prewarm_cooldown");
+  return prewarm_cooldown_;
+}
 u_long Config::temp_throttle() const {
   assert_throttle_mode_("temp_throttle");
   return temp_throttle_;
@@ -416,6 +1111,48 @@ u_long Config::temp_dethrottle() const {
   return temp_dethrottle_;
 }
 uint Config::min_sleep() const { return min_sleep_; }
+uint Config::max_sleep() const { return max_sleep_; }
+bool Config::use_thermal_events() const { return use_thermal_events_; }
+uint Config::thermal_event_timeout() const { return thermal_event_timeout_; }
+const std::string &Config::telemetry_file_path() const {
+  return telemetry_file_path_;
+}
+u_long Config::telemetry_size() const { return telemetry_size_; }
+const std::string &Config::stats_file_path() const { return stats_file_path_; }
+uint Config::stats_interval() const { return stats_interval_; }
+bool Config::use_cgroup() const { return use_cgroup_; }
+const std::string &Config::cgroup_root() const {
+  assert_SIGSTOP_mode_("cgroup_root");
+  return cgroup_root_;
+}
+bool Config::use_cgroup_cpu_max() const {
+  assert_SIGSTOP_mode_("use_cgroup_cpu_max");
+  return use_cgroup_cpu_max_;
+}
+uint Config::cgroup_min_cpu_pct() const {
+  assert_SIGSTOP_mode_("cgroup_min_cpu_pct");
+  return cgroup_min_cpu_pct_;
+}
+const std::string &Config::cgroup_state_path() const {
+  assert_SIGSTOP_mode_("cgroup_state_path");
+  return cgroup_state_path_;
+}
+bool Config::use_proc_events() const {
+  assert_SIGSTOP_mode_("use_proc_events");
+  return use_proc_events_;
+}
+uint Config::proc_rescan_interval() const {
+  assert_SIGSTOP_mode_("proc_rescan_interval");
+  return proc_rescan_interval_;
+}
+const std::string &Config::proc_path() const {
+  assert_SIGSTOP_mode_("proc_path");
+  return proc_path_;
+}
+uint Config::scan_threads() const {
+  assert_SIGSTOP_mode_("scan_threads");
+  return scan_threads_;
+}
 const std::shared_ptr<io::FileCollection<u_long>> &Config::thermal_files() {
   return thermal_files_;
 }
@@ -441,6 +1178,77 @@ const std::vector<std::vector<u_long>> &Config::scaling_available_frequencies()
   assert_throttle_mode_("scaling_available_frequencies");
   return scaling_available_frequencies_;
 }
+const std::vector<FrequencyLadder> &Config::frequency_ladders() const {
+  assert_throttle_mode_("frequency_ladders");
+  return frequency_ladders_;
+}
+const std::vector<std::vector<size_t>> &Config::cpufreq_policies() const {
+  assert_throttle_mode_("cpufreq_policies");
+  return cpufreq_policies_;
+}
+bool Config::use_thermal_domains() const {
+  assert_throttle_mode_("use_thermal_domains");
+  return use_thermal_domains_;
+}
+const std::vector<ThermalDomain> &Config::thermal_domains() const {
+  assert_throttle_mode_("thermal_domains");
+  return thermal_domains_;
+}
+bool Config::use_pid_throttle() const {
+  assert_throttle_mode_("throttle_controller");
+  return throttle_controller_ == "pid";
+}
+u_long Config::temp_target() const {
+  assert_throttle_mode_("temp_target");
+  return temp_target_;
+}
+double Config::pid_kp() const {
+  assert_throttle_mode_("pid_kp");
+  return pid_kp_;
+}
+double Config::pid_ki() const {
+  assert_throttle_mode_("pid_ki");
+  return pid_ki_;
+}
+double Config::pid_kd() const {
+  assert_throttle_mode_("pid_kd");
+  return pid_kd_;
+}
+bool Config::use_rapl() const {
+  assert_throttle_mode_("throttle_actuator");
+  return throttle_actuator_ == "rapl";
+}
+const std::string &Config::matcher_rapl() const {
+  assert_throttle_mode_("matcher_rapl");
+  return matcher_rapl_;
+}
+uint Config::rapl_min_power_pct() const {
+  assert_throttle_mode_("rapl_min_power_pct");
+  return rapl_min_power_pct_;
+}
+uint Config::rapl_step_count() const {
+  assert_throttle_mode_("rapl_step_count");
+  return rapl_step_count_;
+}
+const std::string &Config::rapl_state_path() const {
+  assert_throttle_mode_("rapl_state_path");
+  return rapl_state_path_;
+}
+const std::string &Config::sched_policy() const { return sched_policy_; }
+uint Config::sched_priority() const { return sched_priority_; }
+uint Config::sched_runtime() const { return sched_runtime_; }
+uint Config::sched_period() const { return sched_period_; }
+const std::vector<int> &Config::cpu_affinity() const { return cpu_affinity_; }
+bool Config::use_mlockall() const { return use_mlockall_; }
+u_long Config::mlock_prefault_size() const { return mlock_prefault_size_; }
+bool Config::use_config_watch() const { return use_config_watch_; }
+const std::string &Config::topology_cache_path() const {
+  return topology_cache_path_;
+}
+const Whitelist &Config::whitelist() const {
+  assert_SIGSTOP_mode_("whitelist");
+  return whitelist_;
+}
 
 }  // namespace daemon
 
@@ -19,15 +19,20 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides templimiter::daemon::Config class
  * @date created 2019-02-08
- * @date modified 2019-02-09
+ * @date modified 2026-10-14
  */
 
 #pragma once
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "templimiter/daemon/frequency-ladder.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/daemon/topology-cache.h"
+#include "templimiter/daemon/whitelist.h"
 #include "templimiter/error/config-error.h"
 #include "templimiter/error/error.h"
 #include "templimiter/io/file-collection.h"
@@ -46,12 +51,12 @@ class Config {
   // Internal variables
   /** @brief String vector used to store loaded configuration text */
   std::vector<std::string> config_lines_;
+  /** @brief Indices of the config lines setting each tag */
+  std::unordered_map<std::string, std::vector<size_t>> tag_indices_;
   /** @brief Holds the pid of the running process */
   pid_t own_pid_;
   /** @brief Location of /proc/self/stat used to find own_pid_ */
   const std::string PROC_SELF_STAT_ = "/proc/self/stat";
-  /** @brief Location of /proc/stat used to find cpu information */
-  const std::string PROC_STAT_ = "/proc/stat";
 
   // Internal pre-derivation config values
   /** @brief Matcher to find thermal files */
@@ -69,10 +74,17 @@ class Config {
   /** @brief Matcher to find scaling_available_frequencies files */
   std::string matcher_scaling_available_frequencies_ =
       "/sys/devices/system/cpu/cpu*/cpufreq/scaling_available_frequencies";
+  /** @brief Matcher to find RAPL long term power limit files */
+  std::string matcher_rapl_ =
+      "/sys/class/powercap/intel-rapl:*/constraint_0_power_limit_uw";
 
   // Private component of config values
   /** @brief File to send logging information */
   std::string log_file_path_ = "/var/log/templimiter.log";
+  /** @brief Whether or not the logfile is written from a background thread */
+  bool use_async_log_ = false;
+  /** @brief Whether or not log timestamps include milliseconds */
+  bool log_milliseconds_ = false;
   /** @brief Prohibits sending SIGSTOP to processes of this pid */
   std::vector<pid_t> whitelist_pid_;
   /** @brief Prohibits sending SIGSTOP to processes of this comm */
@@ -101,6 +113,9 @@ class Config {
   std::vector<uint> whitelist_flags_;
   /** @brief Prohibits sending SIGSTOP to processes of a nice lower than this */
   long whitelist_max_nice_ = -21;
+  /** @brief Prohibits limiting cgroups of this path (under cgroup_root) */
+  std::vector<std::string> whitelist_cgroup_ = {"/init.scope",
+                                                "/system.slice/systemd-*"};
   /** @brief Whether or not throttling should be enabled */
   bool use_throttle_ = true;
   /** @brief Whether or not sending SIGSTOP signals should be enabled */
@@ -118,25 +133,99 @@ class Config {
   u_long temp_SIGSTOP_ = 70000;
   /** @brief Temperature to start sending SIGCONT signals */
   u_long temp_SIGCONT_ = 66000;
+  /** @brief Temperature to start sampling processes (0 to disable) */
+  u_long temp_SIGSTOP_prewarm_ = 0;
+  /** @brief Number of iterations between samples below temp_SIGSTOP */
+  uint prewarm_interval_ = 5;
+  /** @brief Number of cold iterations before process samples are dropped */
+  uint prewarm_cooldown_ = 120;
   /** @brief Temperature to start CPU throttling */
   u_long temp_throttle_ = 66000;
   /** @brief Temperature to start CPU dethrottling */
   u_long temp_dethrottle_ = 60000;
   /** @brief Time to wait between state checks */
   uint min_sleep_ = 500;
+  /** @brief Longest time to wait between state checks while cool and flat */
+  uint max_sleep_ = 500;
+  /** @brief Whether or not to wait for thermal events while idle */
+  bool use_thermal_events_ = false;
+  /** @brief Longest time to wait for a thermal event while idle */
+  uint thermal_event_timeout_ = 5000;
+  /** @brief Location of the binary telemetry file (empty to disable) */
+  std::string telemetry_file_path_ = "";
+  /** @brief Size of the binary telemetry file (in bytes) */
+  u_long telemetry_size_ = 1048576;
+  /** @brief Location of the Prometheus stats textfile (empty to disable) */
+  std::string stats_file_path_ = "";
+  /** @brief Time between stats textfile updates (in milliseconds) */
+  uint stats_interval_ = 10000;
+  /** @brief Whether or not to limit whole cgroups instead of single pids */
+  bool use_cgroup_ = false;
+  /** @brief Location of the cgroup v2 hierarchy */
+  std::string cgroup_root_ = "/sys/fs/cgroup";
+  /** @brief Whether or not to tighten cpu.max instead of freezing cgroups */
+  bool use_cgroup_cpu_max_ = false;
+  /** @brief Lowest cpu.max bandwidth (in percent of one cpu) */
+  uint cgroup_min_cpu_pct_ = 10;
+  /** @brief Where to keep the originals of limited cgroups ("" for off) */
+  std::string cgroup_state_path_ = "/run/templimiter.cgroup";
+  /** @brief Whether or not to track processes with proc connector events */
+  bool use_proc_events_ = false;
+  /** @brief Number of process updates between full /proc rescans */
+  uint proc_rescan_interval_ = 20;
+  /** @brief Location of the proc filesystem scanned by SIGSTOP mode */
+  std::string proc_path_ = "/proc";
+  /** @brief Number of threads that read process stat files */
+  uint scan_threads_ = 1;
+  /** @brief Whether or not each cpu package is throttled on its own */
+  bool use_thermal_domains_ = false;
+  /**
+   * @brief Package id of each thermal file (-1 heats every package); detected
+   * from thermal zone types and hwmon labels if empty
+   */
+  std::vector<int> thermal_domain_packages_;
+  /** @brief Throttle controller: "step" or "pid" */
+  std::string throttle_controller_ = "step";
+  /** @brief Temperature held by the pid throttle controller */
+  u_long temp_target_ = 63000;
+  /** @brief Proportional gain of the pid throttle controller */
+  double pid_kp_ = 0.05;
+  /** @brief Integral gain of the pid throttle controller */
+  double pid_ki_ = 0.005;
+  /** @brief Derivative gain of the pid throttle controller */
+  double pid_kd_ = 0.1;
+  /** @brief Throttle backend: "cpufreq" or "rapl" */
+  std::string throttle_actuator_ = "cpufreq";
+  /** @brief Lowest RAPL power limit, in percent of the original limit */
+  uint rapl_min_power_pct_ = 25;
+  /** @brief Number of RAPL power limit steps below the original limit */
+  uint rapl_step_count_ = 10;
+  /** @brief Where to keep the original RAPL power limits ("" for off) */
+  std::string rapl_state_path_ = "/run/templimiter.rapl";
+  /** @brief Control thread scheduling: "other", "fifo" or "deadline" */
+  std::string sched_policy_ = "other";
+  /** @brief SCHED_FIFO priority of the control thread */
+  uint sched_priority_ = 1;
+  /** @brief SCHED_DEADLINE runtime of the control thread (in microseconds) */
+  uint sched_runtime_ = 5000;
+  /** @brief SCHED_DEADLINE period of the control thread (in microseconds) */
+  uint sched_period_ = 100000;
+  /** @brief Cpus that the control thread may run on (empty for any) */
+  std::vector<int> cpu_affinity_;
+  /** @brief Whether or not to lock every page of the daemon into memory */
+  bool use_mlockall_ = false;
+  /** @brief Heap arena faulted in before the monitor starts (in bytes) */
+  u_long mlock_prefault_size_ = 8388608;
+  /** @brief Whether or not to reload when the config file is written */
+  bool use_config_watch_ = false;
+  /** @brief Where to cache the cpufreq topology between starts ("" for off) */
+  std::string topology_cache_path_ = "";
 
   // Derived private components
   /** @brief Files to get thermal data from */
   std::shared_ptr<io::FileCollection<u_long>> thermal_files_;
   /** @brief Files to get/set current CPU speed */
   std::shared_ptr<io::FileCollection<u_long>> scaling_max_freq_files_;
-  /** @brief Files to get maximum CPU speed */
-  std::shared_ptr<io::FileCollection<u_long>> cpuinfo_max_freq_files_;
-  /** @brief Files to get mininum CPU speed */
-  std::shared_ptr<io::FileCollection<u_long>> cpuinfo_min_freq_files_;
-  /** @brief Files to get supported CPU throttle speeds */
-  std::shared_ptr<io::FileCollection<std::string>>
-      scaling_available_frequencies_files_;
   /** @brief File to get current CPU clock time information */
   std::shared_ptr<io::File<std::string>> proc_stat_file_;
   /** @brief Holds the vector of cpuinfo_max_freq values */
@@ -145,6 +234,21 @@ class Config {
   std::vector<u_long> cpuinfo_min_freqs_;
   /** @brief Holds the matrix of available scaling frequencies */
   std::vector<std::vector<u_long>> scaling_available_frequencies_;
+  /** @brief Holds the throttle steps of each cpu */
+  std::vector<FrequencyLadder> frequency_ladders_;
+  /**
+   * @brief Holds the scaling_max_freq indices of the cpus sharing each cpufreq
+   * policy (the first index of each policy is written on its behalf)
+   */
+  std::vector<std::vector<size_t>> cpufreq_policies_;
+  /** @brief Holds the thermal zones and cpufreq policies of each domain */
+  std::vector<ThermalDomain> thermal_domains_;
+
+  /** @brief detect_zone_package_ result of an x86_pkg_temp zone */
+  static constexpr int PKG_TEMP_ZONE_ = -2;
+
+  /** @brief Whitelist compiled from the whitelist tags */
+  Whitelist whitelist_;
 
   // Internal functions
 
@@ -227,6 +331,15 @@ class Config {
    */
   void assert_SIGSTOP_gte_SIGCONT_() const;
 
+  /**
+   * @brief Asserts that the prewarm temp is not above SIGSTOP temp and that
+   * the prewarm iteration counts are at least 1, if prewarming is enabled
+   *
+   * @throws templimiter::error::ConfigError if temp_SIGSTOP_prewarm is above
+   * temp_SIGSTOP, or if prewarm_interval or prewarm_cooldown is 0
+   */
+  void assert_SIGSTOP_prewarm_valid_() const;
+
   /**
    * @brief Asserts that proc_stat_file_ is sizey
    *
@@ -235,9 +348,87 @@ class Config {
    */
   void assert_proc_stat_file_sizey_(size_t procstat_sz) const;
 
+  /**
+   * @brief Asserts that thermal event timeout is gte min_sleep
+   *
+   * @throws templimiter::error::ConfigError if thermal event timeout is less
+   * than min_sleep
+   */
+  void assert_thermal_event_timeout_gte_min_sleep_() const;
+
+  /**
+   * @brief Asserts that max_sleep is gte min_sleep
+   *
+   * @throws templimiter::error::ConfigError if max_sleep is less than
+   * min_sleep
+   */
+  void assert_max_sleep_gte_min_sleep_() const;
+
+  /**
+   * @brief Asserts that cgroup mode, if enabled, can be used
+   *
+   * @throws templimiter::error::ConfigError if SIGSTOP mode is disabled, no
+   * cgroup v2 hierarchy is found at cgroup_root, or cgroup_min_cpu_pct is 0
+   */
+  void assert_cgroup_mode_usable_() const;
+
+  /**
+   * @brief Asserts that proc_rescan_interval is at least 1
+   *
+   * @throws templimiter::error::ConfigError if proc_rescan_interval is 0
+   */
+  void assert_proc_rescan_interval_sizey_() const;
+
+  /**
+   * @brief Asserts that stats_interval is at least 1 if stats are enabled
+   *
+   * @throws templimiter::error::ConfigError if stats_interval is 0
+   */
+  void assert_stats_interval_sizey_() const;
+
+  /**
+   * @brief Asserts that throttle_controller is known and that the pid gains
+   * are not negative
+   *
+   * @throws templimiter::error::ConfigError if throttle_controller is not
+   * "step" or "pid", or if any pid gain is negative
+   */
+  void assert_throttle_controller_valid_() const;
+
+  /**
+   * @brief Asserts that throttle_actuator is known and that the RAPL tags
+   * are usable
+   *
+   * @throws templimiter::error::ConfigError if throttle_actuator is not
+   * "cpufreq" or "rapl", if the RAPL settings are out of range, or if
+   * matcher_rapl finds no files
+   */
+  void assert_throttle_actuator_valid_() const;
+
+  /**
+   * @brief Asserts that the scheduling and affinity tags of the control
+   * thread are usable together
+   *
+   * @throws templimiter::error::ConfigError if sched_policy is not "other",
+   * "fifo" or "deadline", if the fifo priority or deadline parameters are
+   * out of range, if a cpu_affinity entry is not a cpu number, or if
+   * cpu_affinity is combined with the deadline policy
+   */
+  void assert_sched_valid_() const;
+
+  /**
+   * @brief Asserts that scan_threads is at least 1 and that extra scan
+   * threads can be started by the control thread
+   *
+   * @throws templimiter::error::ConfigError if scan_threads is 0, or if it is
+   * above 1 with the deadline sched_policy
+   */
+  void assert_scan_threads_valid_() const;
+
   // Procedures
   /**
-   * @brief Loads config lines to the private config_lines_
+   * @brief Loads config lines to the private config_lines_ and indexes them
+   * by tag in tag_indices_
    * @param config_path Path to the config file
    */
   void load_config_lines_(const std::string &config_path);
@@ -246,12 +437,72 @@ class Config {
   void get_own_pid_();
 
   /**
-   * @brief Retrieves the index of the tag in the config lines
+   * @brief Retrieves the indices of the tag in the config lines
    *
    * @param tag Tag to search for
-   * @return size_t
+   * @return const std::vector< size_t >& Empty if the tag is not set
+   */
+  const std::vector<size_t> &indices_of_tag_(const std::string &tag) const;
+
+  /**
+   * @brief Reads the cpufreq files that stay fixed until the next boot
+   * (related_cpus and the available, cpuinfo_max and cpuinfo_min
+   * frequencies), on several threads, or from the topology cache when it was
+   * written during this boot with the same matchers
+   *
+   * @return CpufreqTopology
    */
-  std::vector<size_t> indices_of_tag_(const std::string &tag);
+  CpufreqTopology load_cpufreq_topology_();
+
+  /**
+   * @brief Groups the matched scaling_max_freq files into cpufreq policies
+   * using the related_cpus file next to each of them
+   *
+   * @param related_cpus related_cpus of each scaling_max_freq file
+   */
+  void load_cpufreq_policies_(const std::vector<std::string> &related_cpus);
+
+  /**
+   * @brief Detects the package heated by a thermal file from the "Package
+   * id" label of a hwmon input; x86_pkg_temp zones carry no package id and
+   * are mapped by map_pkg_temp_zones_
+   *
+   * @param path Location of the thermal file
+   * @return int Package id, PKG_TEMP_ZONE_ for an x86_pkg_temp zone, or -1
+   * if the file is not a package sensor
+   */
+  int detect_zone_package_(const std::string &path) const;
+
+  /**
+   * @brief Maps the x86_pkg_temp zones to packages. The kernel registers one
+   * whenever the first cpu of a package comes online, so in zone number
+   * order they follow the packages in the order of their lowest cpu
+   *
+   * @param pkg_temp_zones Indices of the x86_pkg_temp thermal files
+   * @param zone_packages Package of each thermal file, set for those zones
+   * @throw templimiter::error::ConfigError if the zones cannot be paired with
+   * the packages, so that thermal_domain_packages must list them
+   */
+  void map_pkg_temp_zones_(const std::vector<size_t> &pkg_temp_zones,
+                           std::vector<int> &zone_packages) const;
+
+  /**
+   * @brief Detects the package of a cpu from the topology directory next to
+   * its cpufreq directory
+   *
+   * @param path Location of the cpu's scaling_max_freq file
+   * @return int Package id, or -1 if unknown
+   */
+  int detect_cpu_package_(const std::string &path) const;
+
+  /**
+   * @brief Groups the cpufreq policies into thermal domains; without
+   * use_thermal_domains, one domain holds every zone and policy
+   *
+   * @throw templimiter::error::ConfigError if thermal_domain_packages does
+   * not list one package for each thermal file
+   */
+  void load_thermal_domains_();
 
   /** @brief Loads all private config values from config lines */
   void load_config_values_();
@@ -276,7 +527,7 @@ class Config {
   template <typename T>
   T load_from_tag_(const std::string &tag, const T &defval) {
     // Try finding the index of the tag in the configuration
-    std::vector<size_t> indices = indices_of_tag_(tag);
+    const std::vector<size_t> &indices = indices_of_tag_(tag);
     if (indices.size() == 0) {
       // Tag is not found, return default
       io::log("Could not find tag <" + tag + "> in config. Using default");
@@ -339,7 +590,7 @@ class Config {
   std::vector<T> load_from_tag_(const std::string &tag,
                                 const std::vector<T> &defval) {
     // Try finding the index of the tag in the configuration
-    std::vector<size_t> indices = indices_of_tag_(tag);
+    const std::vector<size_t> &indices = indices_of_tag_(tag);
     if (indices.size() == 0) {
       // Tag is not found, return default
       io::log("Could not find tag <" + tag + "> in config. Using default");
@@ -385,12 +636,37 @@ class Config {
    */
   explicit Config(const std::string &config_path);
 
+  /**
+   * @brief Adopts the reloadable settings of a newly loaded configuration
+   * (temperatures, sleeps, the whitelist, stepwise and prewarm settings, and
+   * the pid controller tuning), keeping the discovered hardware
+   *
+   * @param next Configuration loaded from the edited file
+   * @return std::vector< std::string > Tags that changed but only take effect
+   * after a restart; if any are returned, nothing was adopted
+   */
+  std::vector<std::string> reload(const Config &next);
+
   /**
    * @brief Returns log_file_path configuration setting.
    * @return const std::string&
    */
   const std::string &log_file_path() const;
 
+  /**
+   * @brief Returns use_async_log configuration setting
+   * @return true if the logfile is written from a background thread
+   * @return false if the logfile is written synchronously
+   */
+  bool use_async_log() const;
+
+  /**
+   * @brief Returns log_milliseconds configuration setting
+   * @return true if log timestamps include milliseconds
+   * @return false if log timestamps end at seconds
+   */
+  bool log_milliseconds() const;
+
   /**
    * @brief Returns whitelist_pid configuration setting
    * @return const std::vector< pid_t >&
@@ -451,6 +727,12 @@ class Config {
    */
   long whitelist_max_nice() const;
 
+  /**
+   * @brief Returns whitelist_cgroup configuration setting
+   * @return const std::vector<std::string>&
+   */
+  const std::vector<std::string> &whitelist_cgroup() const;
+
   /**
    * @brief Returns use_throttle configuration setting
    * @return true if using throttle
@@ -500,6 +782,24 @@ class Config {
    */
   u_long temp_SIGCONT() const;
 
+  /**
+   * @brief Returns temp_SIGSTOP_prewarm configuration setting
+   * @return u_long 0 if prewarming is disabled
+   */
+  u_long temp_SIGSTOP_prewarm() const;
+
+  /**
+   * @brief Returns prewarm_interval configuration setting
+   * @return uint
+   */
+  uint prewarm_interval() const;
+
+  /**
+   * @brief Returns prewarm_cooldown configuration setting
+   * @return uint
+   */
+  uint prewarm_cooldown() const;
+
   /**
    * @brief Returns temp_throttle configuration setting
    * @return u_long
@@ -518,6 +818,106 @@ class Config {
    */
   uint min_sleep() const;
 
+  /**
+   * @brief Returns max_sleep configuration setting
+   * @return uint
+   */
+  uint max_sleep() const;
+
+  /**
+   * @brief Returns use_thermal_events configuration setting
+   * @return true if waiting for thermal events while idle
+   * @return false if polling every min_sleep
+   */
+  bool use_thermal_events() const;
+
+  /**
+   * @brief Returns thermal_event_timeout configuration setting
+   * @return uint
+   */
+  uint thermal_event_timeout() const;
+
+  /**
+   * @brief Returns telemetry_file_path configuration setting
+   * @return const std::string& (empty if telemetry is disabled)
+   */
+  const std::string &telemetry_file_path() const;
+
+  /**
+   * @brief Returns telemetry_size configuration setting
+   * @return u_long
+   */
+  u_long telemetry_size() const;
+
+  /**
+   * @brief Returns stats_file_path configuration setting
+   * @return const std::string&
+   */
+  const std::string &stats_file_path() const;
+
+  /**
+   * @brief Returns stats_interval configuration setting
+   * @return uint
+   */
+  uint stats_interval() const;
+
+  /**
+   * @brief Returns use_cgroup configuration setting
+   * @return true if whole cgroups are limited instead of single pids
+   * @return false if single pids are sent SIGSTOP
+   */
+  bool use_cgroup() const;
+
+  /**
+   * @brief Returns cgroup_root configuration setting
+   * @return const std::string&
+   */
+  const std::string &cgroup_root() const;
+
+  /**
+   * @brief Returns use_cgroup_cpu_max configuration setting
+   * @return true if cgroups are limited by tightening cpu.max
+   * @return false if cgroups are frozen
+   */
+  bool use_cgroup_cpu_max() const;
+
+  /**
+   * @brief Returns cgroup_min_cpu_pct configuration setting
+   * @return uint
+   */
+  uint cgroup_min_cpu_pct() const;
+
+  /**
+   * @brief Returns cgroup_state_path configuration setting
+   * @return const std::string& "" if the original cgroup state is not kept
+   */
+  const std::string &cgroup_state_path() const;
+
+  /**
+   * @brief Returns use_proc_events configuration setting
+   * @return true if processes are tracked with proc connector events
+   * @return false if /proc is rescanned on every update
+   */
+  bool use_proc_events() const;
+
+  /**
+   * @brief Returns proc_rescan_interval configuration setting
+   * @return uint
+   */
+  uint proc_rescan_interval() const;
+
+  /**
+   * @brief Returns proc_path configuration setting
+   * @return const std::string&
+   */
+  const std::string &proc_path() const;
+
+  /**
+   * @brief Returns scan_threads configuration setting
+   * @return uint
+   */
+  uint scan_threads() const;
+
   /**
    * @brief Returns the constructed thermal_files FileCollection object based on
    * the configured matcher
@@ -565,6 +965,161 @@ class Config {
    * @return const std::vector< u_long >&
    */
   const std::vector<std::vector<u_long>> &scaling_available_frequencies() const;
+
+  /**
+   * @brief Returns the frequency ladder of each cpu: the scaling available
+   * frequencies in scaling mode, or the cpuinfo min and max in minmax mode
+   *
+   * @return const std::vector< FrequencyLadder >&
+   */
+  const std::vector<FrequencyLadder> &frequency_ladders() const;
+
+  /**
+   * @brief Returns the scaling_max_freq indices of the cpus sharing each
+   * cpufreq policy
+   *
+   * @return const std::vector< std::vector< size_t > >&
+   */
+  const std::vector<std::vector<size_t>> &cpufreq_policies() const;
+
+  /**
+   * @brief Returns use_thermal_domains configuration setting
+   * @return true if each cpu package is throttled on its own
+   * @return false if every cpu is throttled together
+   */
+  bool use_thermal_domains() const;
+
+  /**
+   * @brief Returns the thermal domains that are throttled independently
+   *
+   * @return const std::vector< ThermalDomain >&
+   */
+  const std::vector<ThermalDomain> &thermal_domains() const;
+
+  /**
+   * @brief Returns whether or not throttle_controller is "pid"
+   * @return true if frequencies follow the pid throttle controller
+   * @return false if frequencies move one step per iteration
+   */
+  bool use_pid_throttle() const;
+
+  /**
+   * @brief Returns temp_target configuration setting
+   * @return u_long
+   */
+  u_long temp_target() const;
+
+  /**
+   * @brief Returns pid_kp configuration setting
+   * @return double
+   */
+  double pid_kp() const;
+
+  /**
+   * @brief Returns pid_ki configuration setting
+   * @return double
+   */
+  double pid_ki() const;
+
+  /**
+   * @brief Returns pid_kd configuration setting
+   * @return double
+   */
+  double pid_kd() const;
+
+  /**
+   * @brief Returns whether or not throttle_actuator is "rapl"
+   * @return true if throttling lowers RAPL package power limits
+   * @return false if throttling lowers scaling_max_freq
+   */
+  bool use_rapl() const;
+
+  /**
+   * @brief Returns matcher_rapl configuration setting
+   * @return const std::string&
+   */
+  const std::string &matcher_rapl() const;
+
+  /**
+   * @brief Returns rapl_min_power_pct configuration setting
+   * @return uint
+   */
+  uint rapl_min_power_pct() const;
+
+  /**
+   * @brief Returns rapl_step_count configuration setting
+   * @return uint
+   */
+  uint rapl_step_count() const;
+
+  /**
+   * @brief Returns rapl_state_path configuration setting
+   * @return const std::string& "" if the original limits are not kept
+   */
+  const std::string &rapl_state_path() const;
+
+  /**
+   * @brief Returns sched_policy configuration setting
+   * @return const std::string&
+   */
+  const std::string &sched_policy() const;
+
+  /**
+   * @brief Returns sched_priority configuration setting
+   * @return uint
+   */
+  uint sched_priority() const;
+
+  /**
+   * @brief Returns sched_runtime configuration setting
+   * @return uint
+   */
+  uint sched_runtime() const;
+
+  /**
+   * @brief Returns sched_period configuration setting
+   * @return uint
+   */
+  uint sched_period() const;
+
+  /**
+   * @brief Returns cpu_affinity configuration setting
+   * @return const std::vector< int >&
+   */
+  const std::vector<int> &cpu_affinity() const;
+
+  /**
+   * @brief Returns use_mlockall configuration setting
+   * @return true if every page of the daemon is locked into memory
+   * @return false if pages may be swapped or reclaimed
+   */
+  bool use_mlockall() const;
+
+  /**
+   * @brief Returns mlock_prefault_size configuration setting
+   * @return u_long
+   */
+  u_long mlock_prefault_size() const;
+
+  /**
+   * @brief Returns use_config_watch configuration setting
+   * @return true if the config file is watched with inotify
+   * @return false if the configuration is only reloaded on SIGHUP
+   */
+  bool use_config_watch() const;
+
+  /**
+   * @brief Returns topology_cache_path configuration setting
+   * @return const std::string& "" if the topology is not cached
+   */
+  const std::string &topology_cache_path() const;
+
+  /**
+   * @brief Returns the whitelist compiled from the whitelist tags
+   *
+   * @return const Whitelist&
+   */
+  const Whitelist &whitelist() const;
 };
 
 }  // namespace daemon
@@ -0,0 +1,215 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file cpufreq-actuator.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::CpufreqActuator class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/cpufreq-actuator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/frequency-ladder.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/error/internal-error.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+void CpufreqActuator::sync_ladder_positions_() {
+  const auto &ladders = cfg_->frequency_ladders();
+  ladder_positions_.clear();
+  for (size_t i = 0; i < expected_frequencies_.size() && i < ladders.size();
+       i++) {
+    ladder_positions_.push_back(ladders[i].find(expected_frequencies_[i]));
+  }
+}
+
+const std::vector<u_long> &CpufreqActuator::cur_speeds_of_pass_() {
+  if (!cur_speeds_) {
+    cur_speeds_ = &cfg_->scaling_max_freq_files()->read();
+    if (cur_speeds_->size() != cfg_->frequency_ladders().size()) {
+      throw error::InternalError(
+          "scaling_max_freq_files size differs from the frequency ladder "
+          "count. This should have been prevented by the initial "
+          "configuration verification.");
+    }
+  }
+  return *cur_speeds_;
+}
+
+bool CpufreqActuator::is_policy_expected_(const std::vector<size_t> &policy) {
+  const auto &cur_speeds = cur_speeds_of_pass_();
+  for (size_t i : policy) {
+    if (cur_speeds[i] != expected_frequencies_[i]) {
+      found_unexpected_ = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+void CpufreqActuator::set_policy_frequency_(
+    const std::vector<size_t> &policy, u_long freq,
+    const FrequencyLadder::Position &pos) {
+  // Every cpu of a policy shares one scaling_max_freq; write it only once,
+  // and only if it changes
+  if (freq != expected_frequencies_[policy.front()]) {
+    pending_freq_indices_.push_back(policy.front());
+    pending_freqs_.push_back(freq);
+  }
+  for (size_t i : policy) {
+    expected_frequencies_[i] = freq;
+    ladder_positions_[i] = pos;
+  }
+}
+
+CpufreqActuator::CpufreqActuator(const std::shared_ptr<Config> &cfg)
+    : cfg_(cfg),
+      expected_frequencies_(cfg_->scaling_max_freq_files()->read()) {
+  sync_ladder_positions_();
+}
+
+std::string CpufreqActuator::setting_name() const { return "frequency"; }
+
+void CpufreqActuator::begin() { cur_speeds_ = nullptr; }
+
+bool CpufreqActuator::is_below_max(const ThermalDomain &domain) {
+  const auto &ladders = cfg_->frequency_ladders();
+  const auto &cur_speeds = cur_speeds_of_pass_();
+  for (size_t p : domain.policies) {
+    for (size_t i : cfg_->cpufreq_policies()[p]) {
+      if (ladders[i].is_below_max(cur_speeds[i])) return true;
+    }
+  }
+  return false;
+}
+
+bool CpufreqActuator::is_above_min(const ThermalDomain &domain) {
+  const auto &ladders = cfg_->frequency_ladders();
+  const auto &cur_speeds = cur_speeds_of_pass_();
+  for (size_t p : domain.policies) {
+    for (size_t i : cfg_->cpufreq_policies()[p]) {
+      if (ladders[i].is_above_min(cur_speeds[i])) return true;
+    }
+  }
+  return false;
+}
+
+void CpufreqActuator::throttle(const ThermalDomain &domain) {
+  const auto &ladders = cfg_->frequency_ladders();
+  for (size_t p : domain.policies) {
+    const auto &policy = cfg_->cpufreq_policies()[p];
+    // Check for unexpected frequency
+    if (!is_policy_expected_(policy)) break;
+    size_t lead = policy.front();
+    if (cfg_->use_scaling_available()) {
+      // Next available lower scaling_avail freq
+      FrequencyLadder::Position pos = ladder_positions_[lead];
+      if (ladders[lead].step_down(pos)) {
+        set_policy_frequency_(policy, ladders[lead].at(pos), pos);
+      }
+    } else {
+      set_policy_frequency_(policy, ladders[lead].min(),
+                            ladders[lead].bottom());
+    }
+  }
+}
+
+void CpufreqActuator::dethrottle(const ThermalDomain &domain) {
+  const auto &ladders = cfg_->frequency_ladders();
+  for (size_t p : domain.policies) {
+    const auto &policy = cfg_->cpufreq_policies()[p];
+    // Check for unexpected frequency
+    if (!is_policy_expected_(policy)) break;
+    size_t lead = policy.front();
+    if (cfg_->use_scaling_available()) {
+      // Next available higher scaling_avail freq
+      FrequencyLadder::Position pos = ladder_positions_[lead];
+      if (ladders[lead].step_up(pos)) {
+        set_policy_frequency_(policy, ladders[lead].at(pos), pos);
+      }
+    } else {
+      set_policy_frequency_(policy, ladders[lead].max(), ladders[lead].top());
+    }
+  }
+}
+
+int CpufreqActuator::set_level(const ThermalDomain &domain, double throttle) {
+  const auto &ladders = cfg_->frequency_ladders();
+  int moved = 0;
+  for (size_t p : domain.policies) {
+    const auto &policy = cfg_->cpufreq_policies()[p];
+    size_t lead = policy.front();
+    const FrequencyLadder &ladder = ladders[lead];
+    // Interpolate between the extremes, then snap down onto the ladder
+    u_long target =
+        ladder.max() - u_long(throttle * double(ladder.max() - ladder.min()));
+    FrequencyLadder::Position pos = ladder.floor(target);
+    u_long freq = ladder.at(pos);
+    if (freq == expected_frequencies_[lead]) continue;
+    // Check for unexpected frequency
+    if (!is_policy_expected_(policy)) break;
+    moved |= freq < expected_frequencies_[lead] ? LOWERED : RAISED;
+    set_policy_frequency_(policy, freq, pos);
+  }
+  return moved;
+}
+
+size_t CpufreqActuator::flush() {
+  size_t written = pending_freqs_.size();
+  if (written > 0) {
+    cfg_->scaling_max_freq_files()->overwrite_each(pending_freq_indices_,
+                                                   pending_freqs_);
+  }
+  pending_freq_indices_.clear();
+  pending_freqs_.clear();
+  return written;
+}
+
+bool CpufreqActuator::is_limited() const {
+  const auto &ladders = cfg_->frequency_ladders();
+  for (size_t i = 0; i < expected_frequencies_.size() && i < ladders.size();
+       i++) {
+    if (ladders[i].is_below_max(expected_frequencies_[i])) return true;
+  }
+  return false;
+}
+
+bool CpufreqActuator::found_unexpected() const { return found_unexpected_; }
+
+void CpufreqActuator::resync() {
+  found_unexpected_ = false;
+  expected_frequencies_ = cfg_->scaling_max_freq_files()->read();
+  sync_ladder_positions_();
+}
+
+const std::vector<u_long> &CpufreqActuator::settings() const {
+  return expected_frequencies_;
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
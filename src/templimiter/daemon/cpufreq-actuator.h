@@ -0,0 +1,136 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file cpufreq-actuator.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::CpufreqActuator class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/frequency-ladder.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/daemon/throttle-actuator.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Throttle backend that lowers the scaling_max_freq ceiling of each
+ * cpufreq policy, one scaling_available_frequencies step at a time (scaling
+ * mode) or straight to the cpuinfo extremes (minmax mode)
+ */
+class CpufreqActuator : public ThrottleActuator {
+ private:
+  /** @brief Shared pointer to the execution configuration */
+  std::shared_ptr<Config> cfg_;
+
+  /**
+   * @brief Tracks the expected values of the scaling_max_freq files based on
+   * throttling actions in order to determine whether or not the files are
+   * being modified elsewhere
+   */
+  std::vector<u_long> expected_frequencies_;
+
+  /**
+   * @brief Position of each expected frequency on its cpu's frequency ladder
+   */
+  std::vector<FrequencyLadder::Position> ladder_positions_;
+
+  /** @brief scaling_max_freq indices queued for writing this pass */
+  std::vector<size_t> pending_freq_indices_;
+
+  /** @brief Frequencies queued for writing this pass */
+  std::vector<u_long> pending_freqs_;
+
+  /** @brief Current speeds read during this pass (null until needed) */
+  const std::vector<u_long> *cur_speeds_ = nullptr;
+
+  /**
+   * @brief Whether or not a cpu frequency reading was not as expected (based
+   * on previous throttle actions)
+   */
+  bool found_unexpected_ = false;
+
+  /** @brief Recomputes ladder_positions_ from expected_frequencies_ */
+  void sync_ladder_positions_();
+
+  /**
+   * @brief Returns the current speeds, reading them once per pass
+   *
+   * @return const std::vector< u_long >&
+   * @throw templimiter::error::InternalError if the cpu count differs from
+   * the frequency ladder count
+   */
+  const std::vector<u_long> &cur_speeds_of_pass_();
+
+  /**
+   * @brief Checks whether or not every cpu of a policy is at its expected
+   * frequency, flagging found_unexpected_ if not
+   *
+   * @param policy Indices of the cpus sharing a cpufreq policy
+   * @return true if all cpus are as expected
+   * @return false if any cpu was modified elsewhere
+   */
+  bool is_policy_expected_(const std::vector<size_t> &policy);
+
+  /**
+   * @brief Sets the frequency of a cpufreq policy, queueing a write of the
+   * first cpu's scaling_max_freq only if the frequency changes
+   *
+   * @param policy Indices of the cpus sharing a cpufreq policy
+   * @param freq New frequency
+   * @param pos Ladder position of the new frequency
+   */
+  void set_policy_frequency_(const std::vector<size_t> &policy, u_long freq,
+                             const FrequencyLadder::Position &pos);
+
+ public:
+  /**
+   * @brief Construct a new CpufreqActuator object
+   *
+   * @param cfg Shared pointer to the execution configuration
+   */
+  explicit CpufreqActuator(const std::shared_ptr<Config> &cfg);
+
+  std::string setting_name() const override;
+  void begin() override;
+  bool is_below_max(const ThermalDomain &domain) override;
+  bool is_above_min(const ThermalDomain &domain) override;
+  void throttle(const ThermalDomain &domain) override;
+  void dethrottle(const ThermalDomain &domain) override;
+  int set_level(const ThermalDomain &domain, double throttle) override;
+  size_t flush() override;
+  bool is_limited() const override;
+  bool found_unexpected() const override;
+  void resync() override;
+  const std::vector<u_long> &settings() const override;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,97 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file frequency-ladder.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::FrequencyLadder class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/frequency-ladder.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "templimiter/error/argument-error.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+FrequencyLadder::FrequencyLadder(std::vector<u_long> frequencies)
+    : steps_(std::move(frequencies)) {
+  if (steps_.size() == 0) {
+    throw error::ArgumentError(
+        "frequencies", "std::vector<u_long>", "{ 800000, 2400000 }",
+        "No frequencies provided during construction of the FrequencyLadder.");
+  }
+  std::sort(steps_.begin(), steps_.end());
+  steps_.erase(std::unique(steps_.begin(), steps_.end()), steps_.end());
+  size_t n = steps_.size();
+  // A single step is its own neighbour
+  max_median_ = (steps_[n - 1] + steps_[n > 1 ? n - 2 : 0]) / 2;
+  min_median_ = (steps_[0] + steps_[n > 1 ? 1 : 0]) / 2;
+}
+
+size_t FrequencyLadder::size() const { return steps_.size(); }
+u_long FrequencyLadder::min() const { return steps_.front(); }
+u_long FrequencyLadder::max() const { return steps_.back(); }
+u_long FrequencyLadder::at(const Position &pos) const {
+  return steps_[pos.index];
+}
+FrequencyLadder::Position FrequencyLadder::bottom() const { return {0, true}; }
+FrequencyLadder::Position FrequencyLadder::top() const {
+  return {steps_.size() - 1, true};
+}
+
+FrequencyLadder::Position FrequencyLadder::find(u_long frequency) const {
+  auto it = std::lower_bound(steps_.begin(), steps_.end(), frequency);
+  return {size_t(it - steps_.begin()), it != steps_.end() && *it == frequency};
+}
+
+FrequencyLadder::Position FrequencyLadder::floor(u_long frequency) const {
+  auto it = std::upper_bound(steps_.begin(), steps_.end(), frequency);
+  if (it == steps_.begin()) return bottom();
+  return {size_t(it - steps_.begin()) - 1, true};
+}
+
+bool FrequencyLadder::step_up(Position &pos) const {
+  // An inexact position already refers to the next higher step
+  size_t next = pos.exact ? pos.index + 1 : pos.index;
+  if (next >= steps_.size()) return false;
+  pos = {next, true};
+  return true;
+}
+
+bool FrequencyLadder::step_down(Position &pos) const {
+  if (pos.index == 0) return false;
+  pos = {pos.index - 1, true};
+  return true;
+}
+
+bool FrequencyLadder::is_below_max(u_long speed) const {
+  return speed < max_median_;
+}
+bool FrequencyLadder::is_above_min(u_long speed) const {
+  return speed > min_median_;
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,166 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file frequency-ladder.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::FrequencyLadder class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Sorted, deduplicated throttle steps of one cpu, along with the
+ * median thresholds used to decide whether the cpu is throttled
+ */
+class FrequencyLadder {
+ public:
+  /** @brief Location of a frequency on the ladder */
+  struct Position {
+    /** @brief Index of the first step not below the frequency */
+    size_t index;
+    /** @brief Whether or not the frequency is exactly on that step */
+    bool exact;
+  };
+
+ private:
+  /** @brief Available frequencies in ascending order */
+  std::vector<u_long> steps_;
+
+  /**
+   * @brief Median of the two highest steps; speeds below this are considered
+   * throttled (prevents slight system throttling from appearing as throttled)
+   */
+  u_long max_median_;
+
+  /**
+   * @brief Median of the two lowest steps; speeds above this are considered
+   * not fully throttled
+   */
+  u_long min_median_;
+
+ public:
+  /**
+   * @brief Construct a new FrequencyLadder object
+   *
+   * @param frequencies Available frequencies in any order
+   * @throw templimiter::error::ArgumentError if frequencies is empty
+   */
+  explicit FrequencyLadder(std::vector<u_long> frequencies);
+
+  /**
+   * @brief Returns the number of steps
+   * @return size_t
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns the lowest frequency
+   * @return u_long
+   */
+  u_long min() const;
+
+  /**
+   * @brief Returns the highest frequency
+   * @return u_long
+   */
+  u_long max() const;
+
+  /**
+   * @brief Returns the frequency of the step at a position
+   *
+   * @param pos Position on the ladder (index must be less than size)
+   * @return u_long
+   */
+  u_long at(const Position &pos) const;
+
+  /**
+   * @brief Returns the position of the lowest step
+   * @return Position
+   */
+  Position bottom() const;
+
+  /**
+   * @brief Returns the position of the highest step
+   * @return Position
+   */
+  Position top() const;
+
+  /**
+   * @brief Finds the position of a frequency that may not be on the ladder
+   *
+   * @param frequency Frequency to find
+   * @return Position
+   */
+  Position find(u_long frequency) const;
+
+  /**
+   * @brief Finds the highest step that is not above a frequency
+   *
+   * @param frequency Frequency to snap
+   * @return Position The lowest step if every step is above the frequency
+   */
+  Position floor(u_long frequency) const;
+
+  /**
+   * @brief Moves a position to the next higher step
+   *
+   * @param pos Position to move
+   * @return true if moved
+   * @return false if already at or above the highest step
+   */
+  bool step_up(Position &pos) const;
+
+  /**
+   * @brief Moves a position to the next lower step
+   *
+   * @param pos Position to move
+   * @return true if moved
+   * @return false if already at or below the lowest step
+   */
+  bool step_down(Position &pos) const;
+
+  /**
+   * @brief Checks whether or not a speed is considered throttled
+   *
+   * @param speed Current speed
+   * @return true if below the median of the two highest steps
+   * @return false otherwise
+   */
+  bool is_below_max(u_long speed) const;
+
+  /**
+   * @brief Checks whether or not a speed is considered above minimum
+   *
+   * @param speed Current speed
+   * @return true if above the median of the two lowest steps
+   * @return false otherwise
+   */
+  bool is_above_min(u_long speed) const;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
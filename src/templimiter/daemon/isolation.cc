@@ -0,0 +1,192 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file isolation.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides templimiter::daemon::isolate_control_thread
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/isolation.h"
+
+#include <malloc.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+#include "templimiter/tools/type-convert.h"
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief Stack depth faulted in before the monitor starts (in bytes) */
+constexpr size_t PREFAULT_STACK_SIZE = 256 * 1024;
+
+/** @brief Argument of the sched_setattr syscall (see sched_setattr(2)) */
+struct SchedAttr {
+  uint32_t size;
+  uint32_t sched_policy;
+  uint64_t sched_flags;
+  int32_t sched_nice;
+  uint32_t sched_priority;
+  uint64_t sched_runtime;
+  uint64_t sched_deadline;
+  uint64_t sched_period;
+};
+
+/**
+ * @brief Reports a refused isolation step
+ *
+ * @param out Execution logger
+ * @param what Description of the step
+ */
+void warn(const std::shared_ptr<Logger> &out, const std::string &what) {
+  std::string reason = std::strerror(errno);
+  out->err("[Warning] Could not " + what + " (" + reason +
+           "). Continuing without it.");
+}
+
+/**
+ * @brief Touches every page of a stack frame so that deeper calls in the
+ * monitor never fault
+ */
+[[gnu::noinline]] void prefault_stack() {
+  char frame[PREFAULT_STACK_SIZE];
+  // Written through a volatile pointer so that the stores are kept
+  volatile char *touch = frame;
+  long page = ::sysconf(_SC_PAGESIZE);
+  for (size_t i = 0; i < PREFAULT_STACK_SIZE; i += size_t(page)) touch[i] = 0;
+}
+
+/**
+ * @brief Faults in a heap arena and keeps it in the process after it is
+ * freed, so that later allocations reuse locked pages
+ *
+ * @param size Arena size (in bytes)
+ * @return true if the arena was faulted in
+ * @return false if it could not be allocated
+ */
+bool prefault_heap(size_t size) {
+  // Never return freed memory to the kernel, and serve large blocks from
+  // the heap rather than from fresh mappings
+  ::mallopt(M_TRIM_THRESHOLD, -1);
+  ::mallopt(M_MMAP_MAX, 0);
+  if (size == 0) return true;
+  auto *arena = static_cast<volatile char *>(std::malloc(size));
+  if (!arena) return false;
+  long page = ::sysconf(_SC_PAGESIZE);
+  for (size_t i = 0; i < size; i += size_t(page)) arena[i] = 0;
+  std::free(const_cast<char *>(arena));
+  return true;
+}
+
+/**
+ * @brief Pins the calling thread to the configured cpus
+ *
+ * @param cfg Execution configuration
+ * @param out Execution logger
+ */
+void set_affinity(const std::shared_ptr<Config> &cfg,
+                  const std::shared_ptr<Logger> &out) {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu : cfg->cpu_affinity()) CPU_SET(cpu, &cpus);
+  // pid 0 is the calling thread
+  if (::sched_setaffinity(0, sizeof(cpus), &cpus) == -1) {
+    warn(out, "pin the control thread to cpu_affinity");
+  }
+}
+
+/**
+ * @brief Locks the daemon into memory and prefaults its stack and heap
+ *
+ * @param cfg Execution configuration
+ * @param out Execution logger
+ */
+void lock_memory(const std::shared_ptr<Config> &cfg,
+                 const std::shared_ptr<Logger> &out) {
+  if (::mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+    warn(out, "lock the daemon into memory");
+    return;
+  }
+  prefault_stack();
+  // Built first; a failed allocation reports through errno
+  std::string what = "prefault " +
+                     tools::to_string(cfg->mlock_prefault_size()) +
+                     " heap bytes";
+  if (!prefault_heap(cfg->mlock_prefault_size())) warn(out, what);
+}
+
+/**
+ * @brief Applies the configured real-time policy to the calling thread
+ *
+ * @param cfg Execution configuration
+ * @param out Execution logger
+ */
+void set_scheduler(const std::shared_ptr<Config> &cfg,
+                   const std::shared_ptr<Logger> &out) {
+  if (cfg->sched_policy() == "fifo") {
+    sched_param param{};
+    param.sched_priority = int(cfg->sched_priority());
+    // pid 0 is the calling thread
+    if (::sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+      warn(out, "set the SCHED_FIFO policy");
+    }
+  } else if (cfg->sched_policy() == "deadline") {
+    // glibc has no wrapper for sched_setattr on most supported systems
+    SchedAttr attr{};
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_runtime = uint64_t(cfg->sched_runtime()) * 1000;
+    attr.sched_deadline = uint64_t(cfg->sched_period()) * 1000;
+    attr.sched_period = uint64_t(cfg->sched_period()) * 1000;
+    if (::syscall(SYS_sched_setattr, 0, &attr, 0) == -1) {
+      warn(out, "set the SCHED_DEADLINE policy");
+    }
+  }
+}
+
+}  // namespace
+
+void isolate_control_thread(const std::shared_ptr<Config> &cfg,
+                            const std::shared_ptr<Logger> &out) {
+  // Affinity first: deadline tasks may not change it afterwards
+  if (!cfg->cpu_affinity().empty()) set_affinity(cfg, out);
+  if (cfg->use_mlockall()) lock_memory(cfg, out);
+  set_scheduler(cfg, out);
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
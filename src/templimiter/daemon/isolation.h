@@ -0,0 +1,56 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file isolation.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides templimiter::daemon::isolate_control_thread
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Keeps the calling (control) thread responsive on a saturated
+ * system: pins it to cpu_affinity, locks the daemon into memory with a
+ * prefaulted heap arena, and applies the sched_policy
+ *
+ * Call it before constructing the Monitor so that the monitor's own
+ * allocations land in the prefaulted arena. Threads that already exist
+ * (e.g. the async log writer) keep their scheduling and affinity; the
+ * control thread never waits on them. Every
+ * step that the system refuses is reported as a warning and skipped; the
+ * daemon keeps running at normal priority rather than not at all.
+ *
+ * @param cfg Shared pointer to the execution configuration
+ * @param out Shared pointer to the execution logger
+ */
+void isolate_control_thread(const std::shared_ptr<Config> &cfg,
+                            const std::shared_ptr<Logger> &out);
+
+}  // namespace daemon
+
+}  // namespace templimiter
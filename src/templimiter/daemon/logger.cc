@@ -19,13 +19,18 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides templimiter::daemon::Logger class
  * @date created 2019-01-31
- * @date modified 2019-02-14
+ * @date modified 2026-10-14
  */
 
 #include "templimiter/daemon/logger.h"
 
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "templimiter/daemon/timestamp-cache.h"
+#include "templimiter/io/async-log-writer.h"
 #include "templimiter/io/file.h"
 #include "templimiter/tools/type-convert.h"
 #include "version.h"
@@ -34,12 +39,36 @@ namespace templimiter {
 
 namespace daemon {
 
-std::string Logger::gen_timestamp_() {
-  time_t now;
-  time(&now);
-  char buf[25];
-  strftime(buf, 25, "%FT%T%z", localtime(&now));
-  return buf;
+const std::string &Logger::gen_timestamp_() { return timestamps_.get(); }
+
+void Logger::write_(const std::string &line) {
+  std::chrono::steady_clock::time_point begin;
+  if (is_timed_) begin = std::chrono::steady_clock::now();
+  if (async_writer_) {
+    if (async_writer_->push(line + '\n')) lines_written_++;
+  } else {
+    logfile_.append(line);
+    lines_written_++;
+  }
+  if (is_timed_) write_time_ += std::chrono::steady_clock::now() - begin;
+}
+
+void Logger::write_(const std::vector<std::string> &lines) {
+  std::chrono::steady_clock::time_point begin;
+  if (is_timed_) begin = std::chrono::steady_clock::now();
+  if (async_writer_) {
+    for (const auto &line : lines) {
+      if (async_writer_->push(line + '\n')) lines_written_++;
+    }
+  } else {
+    logfile_.append(lines);
+    lines_written_ += lines.size();
+  }
+  if (is_timed_) write_time_ += std::chrono::steady_clock::now() - begin;
+}
+
+void Logger::flush_() {
+  if (async_writer_) async_writer_->flush();
 }
 
 void Logger::write_welcome_text_() {
@@ -75,10 +104,18 @@ void Logger::write_welcome_text_() {
 Logger::Logger(const std::shared_ptr<Config> &cfg, bool is_debug_mode)
     : cfg_(cfg),
       is_debug_mode_(is_debug_mode),
+      is_timed_(!cfg->stats_file_path().empty()),
+      timestamps_(cfg->log_milliseconds()),
       logfile_(io::File<std::string>(cfg->log_file_path())) {
+  if (cfg_->use_async_log()) {
+    async_writer_ = std::make_shared<io::AsyncLogWriter>(cfg_->log_file_path());
+  }
   write_welcome_text_();
 }
 
+u_long Logger::lines_written() const { return lines_written_; }
+std::chrono::nanoseconds Logger::write_time() const { return write_time_; }
+
 }  // namespace daemon
 
 }  // namespace templimiter
@@ -19,14 +19,19 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides templimiter::daemon::Logger class
  * @date created 2019-01-31
- * @date modified 2019-02-14
+ * @date modified 2026-10-14
  */
 
 #pragma once
 
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "templimiter/daemon/config.h"
+#include "templimiter/daemon/timestamp-cache.h"
+#include "templimiter/io/async-log-writer.h"
 #include "templimiter/io/file.h"
 #include "templimiter/io/operations.h"
 #include "templimiter/tools/type-convert.h"
@@ -45,15 +50,47 @@ class Logger {
   /** @brief Whether or not logs should go to stdout as well */
   bool is_debug_mode_;
 
+  /** @brief Whether or not writes are timed (stats are enabled) */
+  bool is_timed_;
+
+  /** @brief Cached timestamp formatter */
+  TimestampCache timestamps_;
+
   /** @brief Logfile file object */
   io::File<std::string> logfile_;
 
+  /** @brief Background logfile writer (null unless use_async_log is set) */
+  std::shared_ptr<io::AsyncLogWriter> async_writer_;
+
+  /** @brief Number of lines written */
+  u_long lines_written_ = 0;
+
+  /** @brief Time spent writing lines (zero unless timed) */
+  std::chrono::nanoseconds write_time_{0};
+
+  /**
+   * @brief Appends a line to the logfile
+   *
+   * @param line Line to append
+   */
+  void write_(const std::string &line);
+
+  /**
+   * @brief Appends lines to the logfile
+   *
+   * @param lines Lines to append
+   */
+  void write_(const std::vector<std::string> &lines);
+
+  /** @brief Wakes the async writer to write every queued line now */
+  void flush_();
+
   /**
    * @brief Generates a string timestamp
    *
-   * @return std::string
+   * @return const std::string& (valid until the next call)
    */
-  std::string gen_timestamp_();
+  const std::string &gen_timestamp_();
 
   /** @brief Logs a welcome text with title and version */
   void write_welcome_text_();
@@ -68,6 +105,18 @@ class Logger {
    */
   explicit Logger(const std::shared_ptr<Config> &cfg, bool is_debug_mode);
 
+  /**
+   * @brief Returns the number of lines written
+   * @return u_long
+   */
+  u_long lines_written() const;
+
+  /**
+   * @brief Returns the time spent writing lines
+   * @return std::chrono::nanoseconds zero unless stats_file_path is set
+   */
+  std::chrono::nanoseconds write_time() const;
+
   /**
    * @brief Logs any kind of non-vector data
    *
@@ -77,7 +126,7 @@ class Logger {
   template <typename T>
   void log(const T &data) {
     std::string line = "[" + gen_timestamp_() + "] " + tools::to_string(data);
-    logfile_.append(line);
+    write_(line);
     if (is_debug_mode_) io::log(line);
   }
 
@@ -98,7 +147,7 @@ class Logger {
           tools::join(tools::fill<std::string>(lines_header.size(), " "), "") +
           tools::to_string(data[i]));
     }
-    logfile_.append(lines);
+    write_(lines);
     if (is_debug_mode_) io::log(lines);
   }
 
@@ -114,8 +163,8 @@ class Logger {
     std::string err_header = "<!--- An error has occurred! ---!>";
     std::string err_line = timestamp + err_header;
     std::string line = timestamp + tools::to_string(data);
-    logfile_.append(err_line);
-    logfile_.append(line);
+    write_(std::vector<std::string>{err_line, line});
+    flush_();
     if (is_debug_mode_) io::err(err_line);
     if (is_debug_mode_) io::err(line);
   }
@@ -138,7 +187,8 @@ class Logger {
           tools::join(tools::fill<std::string>(timestamp.size(), " "), "") +
           tools::to_string(data[i]));
     }
-    logfile_.append(lines);
+    write_(lines);
+    flush_();
     if (is_debug_mode_) io::err(lines);
   }
 };
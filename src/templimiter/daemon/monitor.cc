@@ -19,24 +19,38 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides the templimiter::daemon::Monitor class
  * @date created 2019-02-09
- * @date modified 2019-02-15
+ * @date modified 2026-10-14
  */
 
 #include "templimiter/daemon/monitor.h"
 
+#include <poll.h>
+#include <sys/types.h>
 #include <algorithm>
-#include <chrono>
+#include <cerrno>
+#include <cstring>
 #include <limits>
 #include <memory>
-#include <numeric>
-#include <thread>
+#include <string>
 #include <vector>
 
+#include "templimiter/daemon/cgroup-limiter.h"
 #include "templimiter/daemon/config.h"
+#include "templimiter/daemon/cpufreq-actuator.h"
 #include "templimiter/daemon/logger.h"
-#include "templimiter/daemon/pid.h"
-#include "templimiter/error/error.h"
+#include "templimiter/daemon/pid-limiter.h"
+#include "templimiter/daemon/process-limiter.h"
+#include "templimiter/daemon/rapl-actuator.h"
+#include "templimiter/daemon/sleep-scheduler.h"
+#include "templimiter/daemon/stats.h"
+#include "templimiter/daemon/sysfs-thermal-sensor.h"
+#include "templimiter/daemon/telemetry.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/daemon/thermal-sensor.h"
+#include "templimiter/daemon/throttle-actuator.h"
+#include "templimiter/daemon/throttle-controller.h"
 #include "templimiter/error/internal-error.h"
+#include "templimiter/io/thermal-events.h"
 #include "templimiter/tools/type-convert.h"
 #include "templimiter/tools/vector.h"
 
@@ -44,377 +58,332 @@ namespace templimiter {
 
 namespace daemon {
 
-u_long Monitor::sum_cur_cpu_time_() {
-  std::vector<std::string> proc_stat_cpu =
-      tools::split(cfg_->proc_stat_file()->read()[0], ' ');
-  std::vector<u_long> cpu_times =
-      tools::convert<u_long>(tools::subvect(proc_stat_cpu, 1, 4));
-  return u_long(std::accumulate(cpu_times.begin(), cpu_times.end(), 0));
-}
+namespace {
 
-void Monitor::update_pids_() {
-  // update processes
-  for (const auto &v : pids_) {
-    v->update(sum_cur_cpu_time_());
-  }
-  // Remove all not_a_process processes
-  pids_ = tools::filter(pids_, [](const auto &v) { return v->is_a_process(); });
-  self_stopped_pids_ = tools::filter(self_stopped_pids_, [](const auto &v) {
-    return v->is_a_process() && v->is_self_stopped();
-  });
-
-  std::vector<std::string> files = io::ls(PROC_FILES_MATCHER_, false);
-
-  auto number_fnames = tools::filter(files, [](const auto &v) {
-    return v.find_first_not_of("0123456789") == std::string::npos;
-  });
-
-  std::vector<pid_t> pid_nums = tools::convert<pid_t>(number_fnames);
-
-  // Add each pid to processes if it does not yet exist there.
-  for (auto test_pid : pid_nums) {
-    if (!std::any_of(pids_.begin(), pids_.end(), [&test_pid](const auto &v) {
-          return v->pid() == test_pid;
-        })) {
-      // processes do not contain this pid
-      pids_.push_back(std::make_shared<Pid>(cfg_, test_pid));
-    }
-  }
+/**
+ * @brief Builds the configured throttle backend
+ *
+ * @param cfg Execution configuration
+ * @return std::shared_ptr< ThrottleActuator > null unless use_throttle is set
+ */
+std::shared_ptr<ThrottleActuator> make_actuator(
+    const std::shared_ptr<Config> &cfg) {
+  if (!cfg->use_throttle()) return nullptr;
+  if (cfg->use_rapl()) return std::make_shared<RaplActuator>(cfg);
+  return std::make_shared<CpufreqActuator>(cfg);
 }
 
-std::vector<std::shared_ptr<Pid>> Monitor::find_SIGSTOP_available_pids_()
-    const {
-  std::vector<std::shared_ptr<Pid>> available;
-  for (const auto &v : pids_) {
-    if (v->is_a_process() && v->is_ready() && !v->is_whitelisted() &&
-        !v->is_self_stopped()) {
-      available.push_back(v);
-    }
-  }
-  return available;
+/**
+ * @brief Builds the configured SIGSTOP mode backend
+ *
+ * @param cfg Execution configuration
+ * @param out Execution logger
+ * @return std::shared_ptr< ProcessLimiter > null unless use_SIGSTOP is set
+ */
+std::shared_ptr<ProcessLimiter> make_limiter(
+    const std::shared_ptr<Config> &cfg, const std::shared_ptr<Logger> &out) {
+  if (!cfg->use_SIGSTOP()) return nullptr;
+  if (cfg->use_cgroup()) return std::make_shared<CgroupLimiter>(cfg, out);
+  return std::make_shared<PidLimiter>(cfg, out);
 }
 
-bool Monitor::is_below_max_speed_(const std::vector<u_long> &cur_speeds) {
-  std::vector<u_long> max_speeds;
-  std::vector<u_long> second_max_speeds;
-  if (cfg_->use_scaling_available()) {
-    for (const auto &v : cfg_->scaling_available_frequencies()) {
-      std::vector<u_long> max_two = tools::max_n_elements(v, 2);
-      max_speeds.push_back(max_two[0]);
-      second_max_speeds.push_back(max_two[1]);
-    }
-  } else {
-    max_speeds = cfg_->cpuinfo_max_freqs();
-    second_max_speeds = cfg_->cpuinfo_min_freqs();
-  }
-  if (cur_speeds.size() != max_speeds.size()) {
-    throw error::InternalError(
-        "scaling_max_freq_files size differs from cpuinfo_max_freq_files size. "
-        "This should have been prevented by the initial configuration "
-        "verification.");
-  }
-  for (size_t i = 0; i < cur_speeds.size(); i++) {
-    u_long median = (max_speeds[i] + second_max_speeds[i]) / 2;
-    // Check for relation to median of max and second max
-    // Prevents slight system throttling from appearing as throttled
-    if (cur_speeds[i] < median) {
-      return true;
-    }
-  }
-  return false;
+}  // namespace
+
+size_t Monitor::stopped_count_() const {
+  return limiter_ ? limiter_->limited_count() : 0;
 }
 
-bool Monitor::is_above_min_speed_(const std::vector<u_long> &cur_speeds) {
-  std::vector<u_long> min_speeds;
-  std::vector<u_long> second_min_speeds;
-  if (cfg_->use_scaling_available()) {
-    for (const auto &v : cfg_->scaling_available_frequencies()) {
-      std::vector<u_long> min_two = tools::min_n_elements(v, 2);
-      min_speeds.push_back(min_two[0]);
-      second_min_speeds.push_back(min_two[1]);
-    }
-  } else {
-    min_speeds = cfg_->cpuinfo_min_freqs();
-    second_min_speeds = cfg_->cpuinfo_max_freqs();
-  }
-  if (cur_speeds.size() != min_speeds.size()) {
-    throw error::InternalError(
-        "scaling_max_freq_files size differs from cpuinfo_min_freq_files size. "
-        "This should have been prevented by the initial configuration "
-        "verification.");
-  }
-  for (size_t i = 0; i < cur_speeds.size(); i++) {
-    u_long median = (min_speeds[i] + second_min_speeds[i]) / 2;
-    // Check for relation to median of max and second max
-    // Prevents slight system throttling from appearing as throttled
-    if (cur_speeds[i] > median) {
-      return true;
-    }
+void Monitor::exec_SIGCONT_() {
+  if (limiter_->limited_count() == 0) return;
+  {
+    Stats::Timer timer(stats_.get(), Stats::PHASE_PROCESSES);
+    limiter_->refresh_limited();
   }
-  return false;
+  Stats::Timer timer(stats_.get(), Stats::PHASE_SIGNALS);
+  bool released = use_stepwise_SIGCONT_ ? limiter_->release_next()
+                                        : limiter_->release_all();
+  if (released) tick_actions_ |= Telemetry::ACTION_CONT;
 }
 
-void Monitor::send_next_SIGCONT_() {
-  // Sort by pid_cpu_pct descending
-  if (self_stopped_pids_.size() > 0) {
-    auto min_available =
-        std::min_element(self_stopped_pids_.begin(), self_stopped_pids_.end(),
-                         [](const auto &a, const auto &b) {
-                           return a->pid_cpu_pct() < b->pid_cpu_pct();
-                         });
-    auto pid_ptr = *min_available;
-    out_->log("Sending SIGCONT to pid " + pid_ptr->pid_str() + " " +
-              pid_ptr->comm());
-    pid_ptr->send_SIGCONT();
+void Monitor::exec_SIGSTOP_() {
+  {
+    Stats::Timer timer(stats_.get(), Stats::PHASE_PROCESSES);
+    limiter_->update();
   }
+  is_table_warm_ = true;
+  ticks_since_update_ = 0;
+  ticks_below_prewarm_ = 0;
+  Stats::Timer timer(stats_.get(), Stats::PHASE_SIGNALS);
+  bool limited =
+      use_stepwise_SIGSTOP_ ? limiter_->limit_next() : limiter_->limit_all();
+  if (limited) tick_actions_ |= Telemetry::ACTION_STOP;
 }
 
-void Monitor::send_next_SIGSTOP_(
-    const std::vector<std::shared_ptr<Pid>> &available_pids) {
-  auto max_available =
-      std::max_element(available_pids.begin(), available_pids.end(),
-                       [](const auto &a, const auto &b) {
-                         return a->pid_cpu_pct() > b->pid_cpu_pct();
-                       });
-  if (max_available != available_pids.end()) {
-    auto pid_ptr = *max_available;
-    out_->log("Sending SIGSTOP to pid " + pid_ptr->pid_str() + " " +
-              pid_ptr->comm());
-    pid_ptr->send_SIGSTOP();
-    self_stopped_pids_.push_back(pid_ptr);
+void Monitor::exec_prewarm_(u_long max_temp) {
+  u_long prewarm_temp = cfg_->temp_SIGSTOP_prewarm();
+  if (prewarm_temp == 0) return;
+  if (max_temp >= prewarm_temp) {
+    ticks_below_prewarm_ = 0;
+    if (is_table_warm_ && ++ticks_since_update_ < cfg_->prewarm_interval()) {
+      return;
+    }
+    Stats::Timer timer(stats_.get(), Stats::PHASE_PROCESSES);
+    limiter_->update();
+    is_table_warm_ = true;
+    ticks_since_update_ = 0;
+  } else if (is_table_warm_ && limiter_->limited_count() == 0 &&
+             ++ticks_below_prewarm_ >= cfg_->prewarm_cooldown()) {
+    // Nothing will be stopped soon; give the process table back
+    limiter_->forget();
+    is_table_warm_ = false;
+    ticks_below_prewarm_ = 0;
   }
 }
 
-void Monitor::send_all_SIGCONTs_() {
-  for (const auto &v : self_stopped_pids_) {
-    v->send_SIGCONT();
-  }
+std::string Monitor::domain_name_(const ThermalDomain &domain) const {
+  if (domain.package == -1) return "CPU";
+  return "CPU package " + tools::to_string(domain.package);
 }
 
-void Monitor::send_all_SIGSTOPs_(
-    const std::vector<std::shared_ptr<Pid>> &available_pids) {
-  for (const auto &v : available_pids) {
-    v->send_SIGSTOP();
-    self_stopped_pids_.push_back(v);
+void Monitor::exec_dethrottle_(const ThermalDomain &domain) {
+  if (actuator_->is_below_max(domain)) {
+    out_->log("Dethrottling " + domain_name_(domain) + ".");
+    tick_actions_ |= Telemetry::ACTION_DETHROTTLE;
+    actuator_->dethrottle(domain);
   }
 }
 
-void Monitor::exec_SIGCONT_() {
-  if (self_stopped_pids_.size() > 0) {
-    update_pids_();
-    if (cfg_->use_stepwise_SIGSTOP()) {
-      send_next_SIGCONT_();
-    } else {
-      send_all_SIGCONTs_();
-    }
+void Monitor::exec_throttle_(const ThermalDomain &domain) {
+  if (actuator_->is_above_min(domain)) {
+    out_->log("Throttling " + domain_name_(domain) + ".");
+    tick_actions_ |= Telemetry::ACTION_THROTTLE;
+    actuator_->throttle(domain);
   }
 }
 
-void Monitor::exec_SIGSTOP_() {
-  update_pids_();
-  auto available_pids = find_SIGSTOP_available_pids_();
-  if (available_pids.size() > 0) {
-    if (cfg_->use_stepwise_SIGSTOP()) {
-      send_next_SIGSTOP_(available_pids);
-    } else {
-      send_all_SIGSTOPs_(available_pids);
-    }
+void Monitor::exec_controlled_throttle_(const ThermalDomain &domain,
+                                        double throttle) {
+  int moved = actuator_->set_level(domain, throttle);
+  if (moved & ThrottleActuator::LOWERED) {
+    out_->log("Throttling " + domain_name_(domain) + ".");
+    tick_actions_ |= Telemetry::ACTION_THROTTLE;
+  }
+  if (moved & ThrottleActuator::RAISED) {
+    out_->log("Dethrottling " + domain_name_(domain) + ".");
+    tick_actions_ |= Telemetry::ACTION_DETHROTTLE;
   }
 }
 
-void Monitor::dethrottle_next_higher_(const std::vector<u_long> &cur_speeds) {
-  std::vector<std::vector<u_long>> scaling_avail =
-      cfg_->scaling_available_frequencies();
-  for (size_t i = 0; i < cur_speeds.size(); i++) {
-    u_long speed = cur_speeds[i];
-    // Check for unexpected frequency
-    if (speed != expected_frequencies_[i]) {
-      found_unexpected_frequency_ = true;
-      break;
+void Monitor::exec_throttling_() {
+  Stats::Timer timer(stats_.get(), Stats::PHASE_THROTTLE);
+  if (actuator_->found_unexpected()) {
+    if (cooldown_ct_ >= unexpected_frequency_cooldown_) {
+      actuator_->resync();
+      cooldown_ct_ = 0;
     }
-    std::vector<u_long> avail_speeds = scaling_avail[i];
-    u_long ul_max = std::numeric_limits<u_long>().max();
-    u_long next = ul_max;
-    for (const auto &v : avail_speeds) {
-      if (v < next && v > speed) next = v;
+    return;
+  }
+  actuator_->begin();
+  const auto &temps = sensor_->temps();
+  const auto &domains = cfg_->thermal_domains();
+  for (size_t d = 0; d < domains.size(); d++) {
+    u_long temp = domains[d].max_temp(temps);
+    if (!throttle_controllers_.empty()) {
+      double throttle = throttle_controllers_[d].update(temp);
+      exec_controlled_throttle_(domains[d], throttle);
+    } else if (temp > cfg_->temp_throttle()) {
+      exec_throttle_(domains[d]);
+    } else if (temp < cfg_->temp_dethrottle()) {
+      exec_dethrottle_(domains[d]);
     }
-    if (next != ul_max) {
-      cfg_->scaling_max_freq_files()->overwrite(i, next);
-      expected_frequencies_[i] = next;
+    if (actuator_->found_unexpected()) break;
+  }
+  {
+    Stats::Timer write_timer(stats_.get(), Stats::PHASE_WRITE);
+    size_t written = actuator_->flush();
+    if (stats_) {
+      stats_->add(Stats::COUNTER_WRITES, written);
+      stats_->add(Stats::COUNTER_WRITES_SKIPPED,
+                  actuator_->settings().size() - written);
     }
   }
+  if (actuator_->found_unexpected()) {
+    // warn the user
+    out_->err("[Warning] Found unexpected " + actuator_->setting_name() +
+              ".\nWaiting " + tools::to_string(unexpected_frequency_cooldown_) +
+              " iterations before reassessment.");
+  }
 }
 
-void Monitor::throttle_next_lower_(const std::vector<u_long> &cur_speeds) {
-  std::vector<std::vector<u_long>> scaling_avail =
-      cfg_->scaling_available_frequencies();
-  for (size_t i = 0; i < cur_speeds.size(); i++) {
-    u_long speed = cur_speeds[i];
-    // Check for unexpected frequency
-    if (speed != expected_frequencies_[i]) {
-      found_unexpected_frequency_ = true;
-      break;
-    }
-    std::vector<u_long> avail_speeds = scaling_avail[i];
-    u_long next = 0;
-    for (const auto &v : avail_speeds) {
-      if (v > next && v < speed) next = v;
-    }
-    if (next != 0) {
-      cfg_->scaling_max_freq_files()->overwrite(i, next);
-      expected_frequencies_[i] = next;
-    }
+bool Monitor::is_idle_(u_long max_temp) {
+  if (max_temp >= release_temp_()) return false;
+  if (actuator_ && (actuator_->found_unexpected() || actuator_->is_limited())) {
+    return false;
   }
+  if (stopped_count_() > 0) return false;
+  return true;
 }
 
-void Monitor::dethrottle_highest_(const std::vector<u_long> &cur_speeds) {
-  std::vector<u_long> max_freqs = cfg_->cpuinfo_max_freqs();
-  for (size_t i = 0; i < cur_speeds.size(); i++) {
-    // Check for unexpected frequency
-    if (cur_speeds[i] != expected_frequencies_[i]) {
-      found_unexpected_frequency_ = true;
-      break;
-    }
-    u_long new_freq = max_freqs[i];
-    cfg_->scaling_max_freq_files()->overwrite(i, new_freq);
-    expected_frequencies_[i] = new_freq;
+u_long Monitor::release_temp_() const {
+  u_long release = std::numeric_limits<u_long>::max();
+  if (actuator_) {
+    release = std::min(release, cfg_->temp_dethrottle());
   }
+  if (limiter_) {
+    release = std::min(release, cfg_->temp_SIGCONT());
+  }
+  return release;
 }
 
-void Monitor::throttle_lowest_(const std::vector<u_long> &cur_speeds) {
-  std::vector<u_long> min_freqs = cfg_->cpuinfo_min_freqs();
-  for (size_t i = 0; i < cur_speeds.size(); i++) {
-    // Check for unexpected frequency
-    if (cur_speeds[i] != expected_frequencies_[i]) {
-      found_unexpected_frequency_ = true;
-      break;
-    }
-    u_long new_freq = min_freqs[i];
-    cfg_->scaling_max_freq_files()->overwrite(i, new_freq);
-    expected_frequencies_[i] = new_freq;
+void Monitor::record_telemetry_(u_long max_temp) {
+  if (telemetry_) {
+    telemetry_->record(max_temp, sensor_->temps(),
+                       actuator_ ? actuator_->settings() : no_settings_,
+                       stopped_count_(), tick_actions_);
   }
+  tick_actions_ = 0;
 }
 
-void Monitor::exec_dethrottle_() {
-  if (found_unexpected_frequency_) {
-    if (cooldown_ct_ >= unexpected_frequency_cooldown_) {
-      found_unexpected_frequency_ = false;
-      expected_frequencies_ = cfg_->scaling_max_freq_files()->read();
-      cooldown_ct_ = 0;
-    }
-  } else {
-    std::vector<u_long> cur_speeds = cfg_->scaling_max_freq_files()->read();
-    if (is_below_max_speed_(cur_speeds)) {
-      out_->log("Dethrottling CPU.");
-      if (cfg_->use_scaling_available()) {
-        dethrottle_next_higher_(cur_speeds);
-      } else {
-        dethrottle_highest_(cur_speeds);
-      }
-      if (found_unexpected_frequency_) {
-        // warn the user
-        out_->err("[Warning] Found unexpected frequency.\nWaiting " +
-                  tools::to_string(unexpected_frequency_cooldown_) +
-                  " iterations before reassessment.");
-      }
-    }
+void Monitor::record_stats_() {
+  if (limiter_) {
+    stats_->set(Stats::COUNTER_SCANNED, limiter_->scanned());
+    stats_->set(Stats::COUNTER_SIGNALS, limiter_->signals());
+    stats_->observe_total(Stats::PHASE_WHITELIST,
+                          Stats::COUNTER_WHITELIST_CHECKS,
+                          limiter_->whitelist_checks(),
+                          limiter_->whitelist_time());
+  }
+  stats_->observe_total(Stats::PHASE_LOGGING, Stats::COUNTER_LOG_LINES,
+                        out_->lines_written(), out_->write_time());
+  if (!stats_->publish_if_due()) {
+    // A full or read-only disk must not stop the control loop
+    out_->err("[Warning] Could not publish stats to " + stats_->path() +
+              " (" + std::strerror(errno) + "). Retrying at the next "
+              "interval.");
   }
 }
 
-void Monitor::exec_throttle_() {
-  if (found_unexpected_frequency_) {
-    if (cooldown_ct_ >= unexpected_frequency_cooldown_) {
-      found_unexpected_frequency_ = false;
-      expected_frequencies_ = cfg_->scaling_max_freq_files()->read();
-      cooldown_ct_ = 0;
+Monitor::Monitor(const std::shared_ptr<Config> &cfg,
+                 const std::shared_ptr<Logger> &out)
+    : Monitor(cfg, out,
+              std::make_shared<SysfsThermalSensor>(cfg->thermal_files()),
+              make_actuator(cfg), make_limiter(cfg, out)) {}
+
+Monitor::Monitor(const std::shared_ptr<Config> &cfg,
+                 const std::shared_ptr<Logger> &out,
+                 const std::shared_ptr<ThermalSensor> &sensor,
+                 const std::shared_ptr<ThrottleActuator> &actuator,
+                 const std::shared_ptr<ProcessLimiter> &limiter)
+    : cfg_(cfg),
+      out_(out),
+      sensor_(sensor),
+      actuator_(actuator),
+      limiter_(limiter),
+      scheduler_(cfg_->min_sleep(), cfg_->max_sleep()) {
+  if (!actuator_ && !limiter_) {
+    throw error::InternalError(
+        "Neither throttling nor SIGSTOP operations are enabled. This should "
+        "have been prevented by the initial configuration verification.");
+  }
+  if (actuator_ && cfg_->use_pid_throttle()) {
+    // One controller per thermal domain, each holding temp_target
+    for (size_t i = 0; i < cfg_->thermal_domains().size(); i++) {
+      throttle_controllers_.emplace_back(cfg_->temp_target(), cfg_->pid_kp(),
+                                         cfg_->pid_ki(), cfg_->pid_kd());
     }
-  } else {
-    std::vector<u_long> cur_speeds = cfg_->scaling_max_freq_files()->read();
-    if (is_above_min_speed_(cur_speeds)) {
-      out_->log("Throttling CPU.");
-      if (cfg_->use_scaling_available()) {
-        throttle_next_lower_(cur_speeds);
-      } else {
-        throttle_lowest_(cur_speeds);
-      }
-      if (found_unexpected_frequency_) {
-        // warn the user
-        out_->err("[Warning] Found unexpected frequency.\nWaiting " +
-                  tools::to_string(unexpected_frequency_cooldown_) +
-                  " iterations before reassessment.");
-      }
+  }
+  if (limiter_) {
+    use_stepwise_SIGSTOP_ = cfg_->use_stepwise_SIGSTOP();
+    use_stepwise_SIGCONT_ = cfg_->use_stepwise_SIGCONT();
+  }
+  if (cfg_->use_thermal_events()) {
+    thermal_events_ = std::make_shared<io::ThermalEvents>();
+    if (!thermal_events_->is_available()) {
+      out_->err(
+          "[Warning] Thermal netlink events are unavailable. Waiting on sysfs "
+          "notifications for at most the scheduled interval while idle.");
     }
   }
+  if (!cfg_->telemetry_file_path().empty()) {
+    telemetry_ = std::make_shared<Telemetry>(
+        cfg_->telemetry_file_path(), cfg_->telemetry_size(), sensor_->size(),
+        actuator_ ? actuator_->settings().size() : 0);
+  }
+  if (!cfg_->stats_file_path().empty()) {
+    stats_ = std::make_shared<Stats>(cfg_->stats_file_path(),
+                                     cfg_->stats_interval());
+  }
 }
 
-[[noreturn]] void Monitor::run_() {
-  const auto sleep = [this]() {
-    std::this_thread::sleep_for(std::chrono::milliseconds(cfg_->min_sleep()));
-  };
-  if (cfg_->use_throttle() && cfg_->use_SIGSTOP()) {
-    // use throttle && SIGSTOP
-    while (true) {
-      u_long max_temp = cfg_->thermal_files()->max_line();
-      if (max_temp > cfg_->temp_throttle() || max_temp > cfg_->temp_SIGSTOP()) {
-        if (max_temp > cfg_->temp_throttle()) {
-          exec_throttle_();
-        }
-        if (max_temp > cfg_->temp_SIGSTOP()) {
-          exec_SIGSTOP_();
-        }
-      } else if (max_temp < cfg_->temp_dethrottle() ||
-                 max_temp < cfg_->temp_SIGCONT()) {
-        if (max_temp < cfg_->temp_dethrottle()) {
-          exec_dethrottle_();
-        }
-        if (max_temp < cfg_->temp_SIGCONT()) {
-          exec_SIGCONT_();
-        }
-      }
-      // Increment throttle cooldown count in main loop
-      if (found_unexpected_frequency_) cooldown_ct_++;
-      sleep();
+Monitor::~Monitor() {}
+
+u_long Monitor::tick() {
+  u_long max_temp;
+  {
+    Stats::Timer timer(stats_.get(), Stats::PHASE_TICK);
+    if (stats_) stats_->add(Stats::COUNTER_TICKS);
+    {
+      Stats::Timer sensor_timer(stats_.get(), Stats::PHASE_SENSOR);
+      max_temp = sensor_->read();
     }
-  } else if (cfg_->use_throttle()) {
-    // use throttle only
-    while (true) {
-      u_long max_temp = cfg_->thermal_files()->max_line();
-      if (max_temp > cfg_->temp_throttle()) {
-        exec_throttle_();
-      } else if (max_temp < cfg_->temp_dethrottle()) {
-        exec_dethrottle_();
-      }
-      // Increment throttle cooldown count in main loop
-      if (found_unexpected_frequency_) cooldown_ct_++;
-      sleep();
+    if (actuator_) {
+      // Each thermal domain decides its own throttling
+      exec_throttling_();
+      // Count the unexpected setting cooldown in ticks
+      if (actuator_->found_unexpected()) cooldown_ct_++;
     }
-  } else if (cfg_->use_SIGSTOP()) {
-    // use SIGSTOP only
-    while (true) {
-      u_long max_temp = cfg_->thermal_files()->max_line();
+    if (limiter_) {
       if (max_temp > cfg_->temp_SIGSTOP()) {
         exec_SIGSTOP_();
-      } else if (max_temp < cfg_->temp_SIGCONT()) {
-        exec_SIGCONT_();
+      } else {
+        if (max_temp < cfg_->temp_SIGCONT()) exec_SIGCONT_();
+        exec_prewarm_(max_temp);
       }
-      sleep();
     }
-  } else {
-    throw error::InternalError(
-        "Neither throttling nor SIGSTOP operations are enabled. This should "
-        "have been prevented by the initial configuration verification.");
+    Stats::Timer telemetry_timer(stats_.get(), Stats::PHASE_TELEMETRY);
+    record_telemetry_(max_temp);
   }
+  // Published outside of the tick so that it is not counted in its time
+  if (stats_) record_stats_();
+  return max_temp;
 }
 
-[[noreturn]] Monitor::Monitor(const std::shared_ptr<Config> &cfg,
-                              const std::shared_ptr<Logger> &out)
-    : cfg_(cfg),
-      out_(out),
-      expected_frequencies_(cfg_->scaling_max_freq_files()->read()) {
-  run_();
+bool Monitor::reload(const Config &next) {
+  std::vector<std::string> restart_tags = cfg_->reload(next);
+  if (!restart_tags.empty()) {
+    out_->err("[Warning] Not reloading the configuration; restart templimiter "
+              "to change " +
+              tools::join(restart_tags, ", ") + ".");
+    return false;
+  }
+  scheduler_.set_bounds(cfg_->min_sleep(), cfg_->max_sleep());
+  for (auto &controller : throttle_controllers_) {
+    controller.retune(cfg_->temp_target(), cfg_->pid_kp(), cfg_->pid_ki(),
+                      cfg_->pid_kd());
+  }
+  if (limiter_) {
+    use_stepwise_SIGSTOP_ = cfg_->use_stepwise_SIGSTOP();
+    use_stepwise_SIGCONT_ = cfg_->use_stepwise_SIGCONT();
+    limiter_->reload_whitelist();
+  }
+  out_->log("Reloaded the configuration.");
+  return true;
 }
 
-Monitor::~Monitor() {}
+void Monitor::wait(u_long max_temp) {
+  bool idle = is_idle_(max_temp);
+  uint interval = scheduler_.next_interval(max_temp, release_temp_(), !idle);
+  if (thermal_events_ && idle) {
+    // Kernel trip points are not templimiter's thresholds, so events may only
+    // end the scheduled wait early, never extend it
+    uint timeout = std::min(interval, cfg_->thermal_event_timeout());
+    thermal_events_->wait(sensor_->descriptors(), int(timeout));
+  } else {
+    // Unlike sleep_for, poll is not restarted after a signal handler, so a
+    // SIGTERM or SIGHUP ends the wait
+    ::poll(nullptr, 0, int(interval));
+  }
+}
 
 }  // namespace daemon
 
@@ -19,39 +19,84 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides the templimiter::daemon::Monitor class
  * @date created 2019-02-09
- * @date modified 2019-02-15
+ * @date modified 2026-10-14
  */
 
 #pragma once
 
+#include <sys/types.h>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "templimiter/daemon/config.h"
 #include "templimiter/daemon/logger.h"
-#include "templimiter/daemon/pid.h"
+#include "templimiter/daemon/process-limiter.h"
+#include "templimiter/daemon/sleep-scheduler.h"
+#include "templimiter/daemon/stats.h"
+#include "templimiter/daemon/telemetry.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/daemon/thermal-sensor.h"
+#include "templimiter/daemon/throttle-actuator.h"
+#include "templimiter/daemon/throttle-controller.h"
+#include "templimiter/io/thermal-events.h"
 
 namespace templimiter {
 
 namespace daemon {
 
-/** @brief Continuously monitors temperature and executes responses */
+/**
+ * @brief Checks temperature and executes responses, one tick at a time
+ *
+ * The sensor and the throttle and SIGSTOP backends are composed once at
+ * construction; a Runner (or any other caller) drives tick() and wait().
+ */
 class Monitor {
  private:
-  /** @brief Matcher used for searching /proc directory */
-  const std::string PROC_FILES_MATCHER_ = "/proc/*";
-
   /** @brief Shared pointer to the execution configuration */
   std::shared_ptr<Config> cfg_;
 
   /** @brief Shared pointer to the execution logger */
   std::shared_ptr<Logger> out_;
 
-  /** @brief Vector of Pid shared pointers */
-  std::vector<std::shared_ptr<Pid>> pids_;
+  /** @brief Temperature source */
+  std::shared_ptr<ThermalSensor> sensor_;
+
+  /** @brief Throttle backend (null unless throttling) */
+  std::shared_ptr<ThrottleActuator> actuator_;
+
+  /** @brief SIGSTOP mode backend (null unless stopping processes) */
+  std::shared_ptr<ProcessLimiter> limiter_;
+
+  /** @brief Whether or not processes are limited one at a time */
+  bool use_stepwise_SIGSTOP_ = false;
+
+  /** @brief Whether or not processes are released one at a time */
+  bool use_stepwise_SIGCONT_ = false;
+
+  /** @brief Whether or not the limiter holds a recent sample */
+  bool is_table_warm_ = false;
 
-  /** @brief Vector of all Pid objects that have been sent SIGSTOP */
-  std::vector<std::shared_ptr<Pid>> self_stopped_pids_;
+  /** @brief Iterations since the limiter was last updated */
+  uint ticks_since_update_ = 0;
+
+  /** @brief Cold iterations, with nothing limited, since the last sample */
+  uint ticks_below_prewarm_ = 0;
+
+  /** @brief Chooses the time to wait between iterations */
+  SleepScheduler scheduler_;
+
+  /** @brief Thermal event source (null unless use_thermal_events is set) */
+  std::shared_ptr<io::ThermalEvents> thermal_events_;
+
+  /** @brief Binary telemetry recorder (null unless telemetry is enabled) */
+  std::shared_ptr<Telemetry> telemetry_;
+
+  /** @brief Phase timing recorder (null unless stats are enabled) */
+  std::shared_ptr<Stats> stats_;
+
+  /** @brief Telemetry action flags of the actions taken this iteration */
+  uint8_t tick_actions_ = 0;
 
   /**
    * @brief Number of iterations to wait before throttling again when
@@ -65,144 +110,169 @@ class Monitor {
    */
   u_short cooldown_ct_ = 0;
 
+  /** @brief Settings recorded to telemetry without a throttle backend */
+  const std::vector<u_long> no_settings_;
+
+  /** @brief Pid throttle controller of each thermal domain (pid mode only) */
+  std::vector<ThrottleController> throttle_controllers_;
+
   /**
-   * @brief Tracks the expected values of the scaling_max_freq files based on 
-   * throttling actions in order to determine whether or not the files are 
-   * being modified elsewhere
+   * @brief Returns the number of pids or cgroups stopped by templimiter
+   *
+   * @return size_t
    */
-  std::vector<u_long> expected_frequencies_;
+  size_t stopped_count_() const;
+
+  /** @brief Performs the SIGCONT operation based on the configuration */
+  void exec_SIGCONT_();
+
+  /** @brief Performs the SIGSTOP operation based on the configuration */
+  void exec_SIGSTOP_();
 
   /**
-   * @brief Whether or not the program has found a cpu frequency reading that
-   * is not as expected (based on previous throttle actions) and is waiting a
-   * few iterations
+   * @brief Samples the limiter every prewarm_interval iterations from
+   * temp_SIGSTOP_prewarm up, so that cpu usage is already known when
+   * temp_SIGSTOP is crossed, and drops the samples after prewarm_cooldown
+   * cold iterations
+   *
+   * @param max_temp Current maximum temperature (at most temp_SIGSTOP)
    */
-  bool found_unexpected_frequency_ = false;
+  void exec_prewarm_(u_long max_temp);
 
   /**
-   * @brief Sums the current cpu time and returns it
-   * @return u_long
+   * @brief Returns the name of a thermal domain used in log messages
+   *
+   * @param domain Thermal domain
+   * @return std::string "CPU" for a domain covering every package
    */
-  u_long sum_cur_cpu_time_();
-
-  /** @brief Updates the pids_ using current information from /proc/ */
-  void update_pids_();
+  std::string domain_name_(const ThermalDomain &domain) const;
 
   /**
-   * @brief Returns a vector of shared pointers to Pid objects that can be sent
-   * SIGSTOP signals
+   * @brief Performs the dethrottle operation of one domain
    *
-   * @return std::vector<std::shared_ptr<Pid>>
+   * @param domain Thermal domain to dethrottle
    */
-  std::vector<std::shared_ptr<Pid>> find_SIGSTOP_available_pids_() const;
+  void exec_dethrottle_(const ThermalDomain &domain);
 
   /**
-   * @brief Checks whether or not any cpu is currently throttled
+   * @brief Performs the throttle operation of one domain
    *
-   * @param cur_speeds Vector of current CPU speeds
-   * @return true if any cpu is throttled
-   * @return false if no cpu is throttled
+   * @param domain Thermal domain to throttle
    */
-  bool is_below_max_speed_(const std::vector<u_long> &cur_speeds);
+  void exec_throttle_(const ThermalDomain &domain);
 
   /**
-   * @brief Checks whether or not any cpu is currently clocked higher than
-   * minimum
+   * @brief Moves a domain to the throttle amount chosen by its throttle
+   * controller
    *
-   * @param cur_speeds Vector of current CPU speeds
-   * @return true if any cpu is throttled
-   * @return false if no cpu is throttled
+   * @param domain Thermal domain to set
+   * @param throttle Throttle amount, from 0 (unlimited) to 1 (fully limited)
    */
-  bool is_above_min_speed_(const std::vector<u_long> &cur_speeds);
+  void exec_controlled_throttle_(const ThermalDomain &domain, double throttle);
 
   /**
-   * @brief Sends a SIGCONT signal to the next lowest-consuming non-whitelisted
-   * process
+   * @brief Throttles or dethrottles every thermal domain by the temperature
+   * of its own zones, and handles the unexpected frequency cooldown
    */
-  void send_next_SIGCONT_();
+  void exec_throttling_();
 
   /**
-   * @brief Sends a SIGSTOP signal to the next highest-consuming non-whitelisted
-   * process
+   * @brief Checks whether or not every response is fully released, allowing
+   * the monitor to wait for thermal events instead of polling
    *
-   * @param available_pids Vector of pointers to Pids that can be sent SIGSTOP
-   * signals
+   * @param max_temp Current maximum temperature
+   * @return true if cool, dethrottled, and no processes are stopped
+   * @return false if a response is active or may soon be required
    */
-  void send_next_SIGSTOP_(
-      const std::vector<std::shared_ptr<Pid>> &available_pids);
-
-  /** @brief Sends a SIGCONT signal to all self stopped processes */
-  void send_all_SIGCONTs_();
+  bool is_idle_(u_long max_temp);
 
   /**
-   * @brief Sends a SIGSTOP signal to all non-whitelisted processes
+   * @brief Returns the temperature below which every response is released
    *
-   * @param available_pids Vector of pointers to Pids that can be sent SIGSTOP
-   * signals
+   * @return u_long
    */
-  void send_all_SIGSTOPs_(
-      const std::vector<std::shared_ptr<Pid>> &available_pids);
-
-  /** @brief Performs the SIGCONT operation based on the configuration */
-  void exec_SIGCONT_();
-
-  /** @brief Performs the SIGSTOP operation based on the configuration */
-  void exec_SIGSTOP_();
+  u_long release_temp_() const;
 
   /**
-   * @brief Dethrottles each cpu to the next available higher scaling_avail freq
+   * @brief Records this iteration to the telemetry file, if enabled, and
+   * resets tick_actions_
    *
-   * @param cur_speeds Vector of current CPU speeds
+   * @param max_temp Maximum temperature found this iteration
    */
-  void dethrottle_next_higher_(const std::vector<u_long> &cur_speeds);
+  void record_telemetry_(u_long max_temp);
 
   /**
-   * @brief Throttles each cpu to the next available lower scaling_avail freq
-   *
-   * @param cur_speeds Vector of current CPU speeds
+   * @brief Collects the counters kept by the backends, the whitelist and the
+   * logger into stats_, and publishes them when due
    */
-  void throttle_next_lower_(const std::vector<u_long> &cur_speeds);
+  void record_stats_();
 
-  /** 
-   * @brief Dethrottles each cpu to the highest possible frequency
-   * 
-   * @param cur_speeds Vector of current CPU speeds
+ public:
+  /**
+   * @brief Construct a new Monitor object from the configured sysfs sensor
+   * and backends
+   *
+   * @param cfg Shared pointer to the execution configuration
+   * @param out Shared pointer to the execution logger
    */
-  void dethrottle_highest_(const std::vector<u_long> &cur_speeds);
+  Monitor(const std::shared_ptr<Config> &cfg,
+          const std::shared_ptr<Logger> &out);
 
-  /** 
-   * @brief Throttles each cpu to the lowest possible frequency
-   * 
-   * @param cur_speeds Vector of current CPU speeds
+  /**
+   * @brief Construct a new Monitor object from supplied components
+   *
+   * A null actuator or limiter disables its response; a non-null one
+   * requires the matching mode in the configuration. The sensor must report
+   * the zones that the configured thermal domains refer to.
+   *
+   * @param cfg Shared pointer to the execution configuration
+   * @param out Shared pointer to the execution logger
+   * @param sensor Temperature source
+   * @param actuator Throttle backend, or null
+   * @param limiter SIGSTOP mode backend, or null
+   * @throw templimiter::error::InternalError if no response is supplied
    */
-  void throttle_lowest_(const std::vector<u_long> &cur_speeds);
+  Monitor(const std::shared_ptr<Config> &cfg,
+          const std::shared_ptr<Logger> &out,
+          const std::shared_ptr<ThermalSensor> &sensor,
+          const std::shared_ptr<ThrottleActuator> &actuator,
+          const std::shared_ptr<ProcessLimiter> &limiter);
 
-  /** @brief Performs the dethrottle operation based on the configuration */
-  void exec_dethrottle_();
+  /**
+   * @brief Destroy the Monitor object
+   */
+  ~Monitor();
 
-  /** @brief Performs the throttle operation based on the configuration */
-  void exec_throttle_();
+  Monitor(const Monitor &) = delete;
+  Monitor &operator=(const Monitor &) = delete;
 
   /**
-   * @brief Loops forever until an error is thrown, checking temperature and
-   * executing responses
+   * @brief Reads the sensor once and executes every response it calls for,
+   * without waiting
+   *
+   * @return u_long Maximum temperature found
    */
-  [[noreturn]] void run_();
+  u_long tick();
 
- public:
   /**
-   * @brief Construct a new Monitor object
+   * @brief Adopts the reloadable settings of a newly loaded configuration;
+   * the throttle amounts and the limited processes are kept as they are
    *
-   * @param cfg Shared pointer to the execution configuration
-   * @param out Shared pointer to the execution logger
+   * @param next Configuration loaded from the edited file
+   * @return true if adopted
+   * @return false if a setting that needs a restart changed (which is
+   * logged, and nothing is adopted)
    */
-  [[noreturn]] Monitor(const std::shared_ptr<Config> &cfg,
-                       const std::shared_ptr<Logger> &out);
+  bool reload(const Config &next);
 
   /**
-   * @brief Destroy the Monitor object
+   * @brief Waits before the next tick; sleeps min_sleep while responding,
+   * or the scheduled interval (at most thermal_event_timeout, and ended early
+   * by thermal events when they are enabled) while idle
+   *
+   * @param max_temp Maximum temperature returned by the last tick
    */
-  ~Monitor();
+  void wait(u_long max_temp);
 };
 
 }  // namespace daemon
@@ -0,0 +1,165 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file pid-heap.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidHeap class template
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "templimiter/daemon/pid-table.h"
+#include "templimiter/tools/vector.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Binary heap of PidTable slots keyed by cpu usage that supports
+ * updating or removing any member in O(log n)
+ *
+ * @tparam Compare Key ordering; std::less keeps the highest key on top and
+ * std::greater keeps the lowest key on top
+ */
+template <typename Compare>
+class PidHeap {
+ private:
+  /** @brief Heap member */
+  struct Node {
+    /** @brief Cpu usage when last updated */
+    float key;
+    /** @brief PidTable slot */
+    PidTable::Handle slot;
+  };
+
+  /** @brief Recorded position of a slot that is not a member */
+  static constexpr size_t NPOS = size_t(-1);
+
+  /** @brief Heap-ordered members */
+  std::vector<Node> nodes_;
+
+  /** @brief Position of each member in nodes_, indexed by slot */
+  std::vector<size_t> positions_;
+
+  /** @brief Key ordering */
+  Compare compare_;
+
+  /** @brief Swaps two members and their recorded positions */
+  void swap_(size_t a, size_t b) {
+    std::swap(nodes_[a], nodes_[b]);
+    positions_[nodes_[a].slot] = a;
+    positions_[nodes_[b].slot] = b;
+  }
+
+  /** @brief Moves a member toward the top until the heap is ordered */
+  size_t sift_up_(size_t i) {
+    while (i > 0) {
+      size_t parent = (i - 1) / 2;
+      if (!compare_(nodes_[parent].key, nodes_[i].key)) break;
+      swap_(i, parent);
+      i = parent;
+    }
+    return i;
+  }
+
+  /** @brief Moves a member toward the bottom until the heap is ordered */
+  void sift_down_(size_t i) {
+    while (true) {
+      size_t best = i;
+      size_t left = 2 * i + 1;
+      size_t right = left + 1;
+      if (left < nodes_.size() && compare_(nodes_[best].key, nodes_[left].key))
+        best = left;
+      if (right < nodes_.size() &&
+          compare_(nodes_[best].key, nodes_[right].key))
+        best = right;
+      if (best == i) return;
+      swap_(i, best);
+      i = best;
+    }
+  }
+
+ public:
+  /** @brief Returns whether or not the heap is empty */
+  bool empty() const { return nodes_.empty(); }
+
+  /** @brief Returns the number of members */
+  size_t size() const { return nodes_.size(); }
+
+  /** @brief Removes every member and frees the heap's storage */
+  void clear() {
+    tools::free_memory(nodes_);
+    tools::free_memory(positions_);
+  }
+
+  /**
+   * @brief Returns the member with the top key
+   *
+   * @return PidTable::Handle
+   */
+  PidTable::Handle top() const { return nodes_.front().slot; }
+
+  /**
+   * @brief Inserts a member or updates its key
+   *
+   * @param slot PidTable slot
+   * @param key Cpu usage
+   */
+  void update(PidTable::Handle slot, float key) {
+    if (slot >= positions_.size()) positions_.resize(slot + 1, NPOS);
+    size_t i = positions_[slot];
+    if (i == NPOS) {
+      positions_[slot] = nodes_.size();
+      nodes_.push_back(Node{key, slot});
+      sift_up_(nodes_.size() - 1);
+      return;
+    }
+    if (nodes_[i].key == key) return;
+    nodes_[i].key = key;
+    if (sift_up_(i) == i) sift_down_(i);
+  }
+
+  /**
+   * @brief Removes a member, if present
+   *
+   * @param slot PidTable slot
+   */
+  void erase(PidTable::Handle slot) {
+    if (slot >= positions_.size() || positions_[slot] == NPOS) return;
+    size_t i = positions_[slot];
+    positions_[slot] = NPOS;
+    size_t last = nodes_.size() - 1;
+    if (i != last) {
+      nodes_[i] = nodes_[last];
+      positions_[nodes_[i].slot] = i;
+    }
+    nodes_.pop_back();
+    if (i < nodes_.size() && sift_up_(i) == i) sift_down_(i);
+  }
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
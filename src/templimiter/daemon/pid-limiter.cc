@@ -0,0 +1,329 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file pid-limiter.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidLimiter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/pid-limiter.h"
+
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+#include "templimiter/daemon/pid-heap.h"
+#include "templimiter/daemon/pid-stat.h"
+#include "templimiter/daemon/pid-table.h"
+#include "templimiter/daemon/stat-scan-pool.h"
+#include "templimiter/daemon/system-snapshot.h"
+#include "templimiter/tools/type-convert.h"
+#include "templimiter/tools/vector.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+void PidLimiter::track_pid_(PidTable::Handle h) {
+  if (table_.is_self_stopped(h)) {
+    stop_candidates_.erase(h);
+    stopped_heap_.update(h, table_.is_ready(h) ? table_.cpu_pct(h) : 0);
+  } else {
+    stopped_heap_.erase(h);
+    if (table_.is_ready(h) && !table_.is_whitelisted(h)) {
+      stop_candidates_.update(h, table_.cpu_pct(h));
+    } else {
+      stop_candidates_.erase(h);
+    }
+  }
+}
+
+void PidLimiter::track_stat_(pid_t pid, const PidStat &stat) {
+  PidTable::Handle h = table_.find(pid);
+  if (h == PidTable::NONE) {
+    table_.insert(pid, stat, scan_generation_);
+  } else {
+    table_.update(h, stat, snapshot_, scan_generation_);
+    track_pid_(h);
+  }
+}
+
+void PidLimiter::merge_scanned_pids_() {
+  scan_pool_->for_each([this](const StatScanPool::Record &record) {
+    scanned_++;
+    track_stat_(record.pid, record.stat);
+  });
+}
+
+void PidLimiter::scan_all_pids_() {
+  proc_scanner_.rewind();
+  pid_t pid_num;
+  if (scan_pool_) {
+    // Listing /proc is cheap; reading every stat file is what gets shared
+    scan_pids_.clear();
+    while (proc_scanner_.next_pid(pid_num)) scan_pids_.push_back(pid_num);
+    scan_pool_->scan(scan_pids_);
+    merge_scanned_pids_();
+    return;
+  }
+  std::string_view stat;
+  PidStat parsed;
+  // Update known processes and add new ones in a single pass over /proc
+  while (proc_scanner_.next(pid_num, stat)) {
+    scanned_++;
+    // Malformed processes are left unseen, and forgotten by update
+    if (parse_pid_stat(stat, parsed)) track_stat_(pid_num, parsed);
+  }
+}
+
+bool PidLimiter::apply_proc_events_() {
+  started_pids_.clear();
+  exited_pids_.clear();
+  if (!proc_events_->drain(started_pids_, exited_pids_)) needs_rescan_ = true;
+  // Rescan now and then in case an event was missed
+  if (++updates_since_rescan_ >= cfg_->proc_rescan_interval()) {
+    needs_rescan_ = true;
+  }
+  if (needs_rescan_) {
+    needs_rescan_ = false;
+    updates_since_rescan_ = 0;
+    return false;
+  }
+  for (pid_t pid : exited_pids_) {
+    PidTable::Handle h = table_.find(pid);
+    if (h != PidTable::NONE) forget_pid_(h);
+  }
+  return true;
+}
+
+void PidLimiter::update_tracked_pids_() {
+  if (scan_pool_) {
+    scan_pids_.clear();
+    table_.for_each(
+        [this](PidTable::Handle h) { scan_pids_.push_back(table_.pid(h)); });
+    for (pid_t pid : started_pids_) {
+      if (table_.find(pid) == PidTable::NONE) scan_pids_.push_back(pid);
+    }
+    scan_pool_->scan(scan_pids_);
+    merge_scanned_pids_();
+    return;
+  }
+  std::string_view stat;
+  PidStat parsed;
+  table_.for_each([&](PidTable::Handle h) {
+    if (proc_scanner_.read_stat(table_.pid(h), stat)) {
+      scanned_++;
+      if (!parse_pid_stat(stat, parsed)) return;
+      table_.update(h, parsed, snapshot_, scan_generation_);
+      track_pid_(h);
+    }
+  });
+  for (pid_t pid : started_pids_) {
+    // An exec'd process that is already known has just been updated
+    if (table_.find(pid) != PidTable::NONE) continue;
+    if (proc_scanner_.read_stat(pid, stat)) {
+      scanned_++;
+      if (parse_pid_stat(stat, parsed)) {
+        table_.insert(pid, parsed, scan_generation_);
+      }
+    }
+  }
+}
+
+void PidLimiter::forget_pid_(PidTable::Handle h) {
+  exit_watcher_.remove(table_.pidfd(h));
+  stop_candidates_.erase(h);
+  stopped_heap_.erase(h);
+  self_stopped_pids_.erase(
+      std::remove(self_stopped_pids_.begin(), self_stopped_pids_.end(), h),
+      self_stopped_pids_.end());
+  table_.erase(h);
+}
+
+void PidLimiter::prune_self_stopped_() {
+  self_stopped_pids_.erase(
+      std::remove_if(self_stopped_pids_.begin(), self_stopped_pids_.end(),
+                     [this](PidTable::Handle h) {
+                       return !table_.is_self_stopped(h);
+                     }),
+      self_stopped_pids_.end());
+}
+
+void PidLimiter::reap_exited_pids_() {
+  exited_pids_.clear();
+  exit_watcher_.collect_exited(exited_pids_);
+  for (pid_t pid : exited_pids_) {
+    PidTable::Handle h = table_.find(pid);
+    if (h != PidTable::NONE) forget_pid_(h);
+  }
+}
+
+bool PidLimiter::is_same_process_(PidTable::Handle h) {
+  std::string_view stat;
+  PidStat parsed;
+  return proc_scanner_.read_stat(table_.pid(h), stat) &&
+         parse_pid_stat(stat, parsed) &&
+         parsed.starttime == table_.starttime(h);
+}
+
+void PidLimiter::stop_pid_(PidTable::Handle h) {
+  // A pidfd is opened by pid number, which may have been reused since the
+  // scan; a matching starttime read after opening proves it is the same
+  // process
+  if (table_.open_pidfd(h) && !is_same_process_(h)) {
+    forget_pid_(h);
+    return;
+  }
+  signals_++;
+  if (!table_.send_SIGSTOP(h)) {
+    forget_pid_(h);
+    return;
+  }
+  stop_candidates_.erase(h);
+  exit_watcher_.add(table_.pidfd(h), table_.pid(h));
+  stopped_heap_.update(h, table_.cpu_pct(h));
+  self_stopped_pids_.push_back(h);
+}
+
+PidLimiter::PidLimiter(const std::shared_ptr<Config> &cfg,
+                       const std::shared_ptr<Logger> &out)
+    : cfg_(cfg), out_(out), proc_scanner_(cfg_->proc_path()), table_(cfg_) {
+  if (cfg_->scan_threads() > 1) {
+    scan_pool_ = std::make_shared<StatScanPool>(cfg_->proc_path(),
+                                                cfg_->scan_threads());
+  }
+  if (cfg_->use_proc_events()) {
+    proc_events_ = std::make_shared<io::ProcEvents>();
+    if (!proc_events_->is_available()) {
+      out_->err(
+          "[Warning] The proc connector is unavailable. Rescanning /proc on "
+          "every process update.");
+      proc_events_.reset();
+    }
+  }
+}
+
+PidLimiter::~PidLimiter() {
+  // Never leave processes stopped behind an exiting daemon
+  release_all();
+}
+
+void PidLimiter::update() {
+  // Read /proc/stat once so every process is measured against one sample
+  snapshot_.update(*cfg_->proc_stat_file());
+  scan_generation_++;
+  if (proc_events_ && apply_proc_events_()) {
+    update_tracked_pids_();
+  } else {
+    scan_all_pids_();
+  }
+  // Remove all processes that were not found or could not be parsed
+  table_.for_each([this](PidTable::Handle h) {
+    if (table_.seen(h) != scan_generation_) forget_pid_(h);
+  });
+  // A reused pid is a new process that was never stopped
+  prune_self_stopped_();
+}
+
+void PidLimiter::refresh_limited() {
+  // Exits of processes stopped through a pidfd arrive as events
+  bool all_watched = std::all_of(
+      self_stopped_pids_.begin(), self_stopped_pids_.end(),
+      [this](PidTable::Handle h) { return table_.pidfd(h) != -1; });
+  if (all_watched) {
+    reap_exited_pids_();
+  } else {
+    update();
+  }
+}
+
+void PidLimiter::forget() {
+  if (!self_stopped_pids_.empty()) return;
+  table_.clear();
+  tools::free_memory(scan_pids_);
+  stop_candidates_.clear();
+  stopped_heap_.clear();
+  // Process events only cover known processes
+  needs_rescan_ = true;
+}
+
+void PidLimiter::reload_whitelist() {
+  table_.recheck_whitelist();
+  table_.for_each([this](PidTable::Handle h) { track_pid_(h); });
+}
+
+bool PidLimiter::limit_next() {
+  if (stop_candidates_.empty()) return false;
+  PidTable::Handle h = stop_candidates_.top();
+  out_->log("Sending SIGSTOP to pid " + tools::to_string(table_.pid(h)) +
+            " " + std::string(table_.comm(h)));
+  stop_pid_(h);
+  return true;
+}
+
+bool PidLimiter::limit_all() {
+  if (stop_candidates_.empty()) return false;
+  while (!stop_candidates_.empty()) stop_pid_(stop_candidates_.top());
+  return true;
+}
+
+bool PidLimiter::release_next() {
+  if (stopped_heap_.empty()) return false;
+  PidTable::Handle h = stopped_heap_.top();
+  out_->log("Sending SIGCONT to pid " + tools::to_string(table_.pid(h)) +
+            " " + std::string(table_.comm(h)));
+  exit_watcher_.remove(table_.pidfd(h));
+  table_.send_SIGCONT(h);
+  signals_++;
+  stopped_heap_.erase(h);
+  prune_self_stopped_();
+  return true;
+}
+
+bool PidLimiter::release_all() {
+  if (self_stopped_pids_.empty()) return false;
+  for (PidTable::Handle h : self_stopped_pids_) {
+    exit_watcher_.remove(table_.pidfd(h));
+    table_.send_SIGCONT(h);
+    signals_++;
+    stopped_heap_.erase(h);
+  }
+  self_stopped_pids_.clear();
+  return true;
+}
+
+size_t PidLimiter::limited_count() const { return self_stopped_pids_.size(); }
+u_long PidLimiter::scanned() const { return scanned_; }
+u_long PidLimiter::signals() const { return signals_; }
+u_long PidLimiter::whitelist_checks() const {
+  return table_.whitelist_checks();
+}
+std::chrono::nanoseconds PidLimiter::whitelist_time() const {
+  return table_.whitelist_time();
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
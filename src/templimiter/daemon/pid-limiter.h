@@ -0,0 +1,220 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file pid-limiter.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidLimiter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/logger.h"
+#include "templimiter/daemon/pid-heap.h"
+#include "templimiter/daemon/pid-stat.h"
+#include "templimiter/daemon/pid-table.h"
+#include "templimiter/daemon/process-limiter.h"
+#include "templimiter/daemon/stat-scan-pool.h"
+#include "templimiter/daemon/system-snapshot.h"
+#include "templimiter/io/exit-watcher.h"
+#include "templimiter/io/proc-events.h"
+#include "templimiter/io/proc-scanner.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Stops single processes, ranked by cpu usage, with SIGSTOP and
+ * continues them with SIGCONT
+ */
+class PidLimiter : public ProcessLimiter {
+ private:
+  /** @brief Shared pointer to the execution configuration */
+  std::shared_ptr<Config> cfg_;
+
+  /** @brief Shared pointer to the execution logger */
+  std::shared_ptr<Logger> out_;
+
+  /** @brief Single-pass scanner of the /proc directory */
+  io::ProcScanner proc_scanner_;
+
+  /** @brief Parallel stat reader (null unless scan_threads is above 1) */
+  std::shared_ptr<StatScanPool> scan_pool_;
+
+  /** @brief Reusable list of pids handed to scan_pool_ */
+  std::vector<pid_t> scan_pids_;
+
+  /** @brief Number of completed /proc scans */
+  u_long scan_generation_ = 0;
+
+  /** @brief Tracked processes */
+  PidTable table_;
+
+  /** @brief Cpu time information shared by every process during one update */
+  SystemSnapshot snapshot_;
+
+  /** @brief Slots of every process that has been sent SIGSTOP */
+  std::vector<PidTable::Handle> self_stopped_pids_;
+
+  /** @brief Pids that can be sent SIGSTOP, highest cpu usage on top */
+  PidHeap<std::less<float>> stop_candidates_;
+
+  /** @brief Self stopped pids, lowest cpu usage on top */
+  PidHeap<std::greater<float>> stopped_heap_;
+
+  /** @brief Reports exits of self stopped processes through their pidfds */
+  io::ExitWatcher exit_watcher_;
+
+  /** @brief Reusable list of exited pids reported by an event source */
+  std::vector<pid_t> exited_pids_;
+
+  /** @brief Process event source (null unless use_proc_events is set) */
+  std::shared_ptr<io::ProcEvents> proc_events_;
+
+  /** @brief Reusable list of forked or exec'd pids reported by proc_events_ */
+  std::vector<pid_t> started_pids_;
+
+  /** @brief Number of process updates since the last full /proc rescan */
+  uint updates_since_rescan_ = 0;
+
+  /** @brief Whether or not the next process update must rescan /proc */
+  bool needs_rescan_ = true;
+
+  /** @brief Number of stat files read since construction */
+  u_long scanned_ = 0;
+
+  /** @brief Number of signals sent since construction */
+  u_long signals_ = 0;
+
+  /**
+   * @brief Updates a found process, or starts tracking it if it is new
+   *
+   * @param pid Pid of the process
+   * @param stat Parsed fields of the /proc/<pid>/stat file
+   */
+  void track_stat_(pid_t pid, const PidStat &stat);
+
+  /** @brief Finds and updates every process by walking /proc/ */
+  void scan_all_pids_();
+
+  /**
+   * @brief Updates the known processes and adds the new ones found by the
+   * last scan_pool_ scan
+   */
+  void merge_scanned_pids_();
+
+  /**
+   * @brief Applies pending proc_events_ exits and decides whether the
+   * tracked processes can be updated without a rescan
+   *
+   * @return true if update_tracked_pids_ may be used
+   * @return false if /proc/ must be rescanned
+   */
+  bool apply_proc_events_();
+
+  /**
+   * @brief Updates the known processes and adds the ones reported by
+   * proc_events_, without walking /proc/
+   */
+  void update_tracked_pids_();
+
+  /**
+   * @brief Removes self stopped processes that exit_watcher_ reports as
+   * exited, without rescanning /proc/
+   */
+  void reap_exited_pids_();
+
+  /**
+   * @brief Forgets a tracked process and frees its slot
+   *
+   * @param h Slot of the process
+   */
+  void forget_pid_(PidTable::Handle h);
+
+  /**
+   * @brief Checks that the process holding a pid is still the one that was
+   * scanned, by its starttime
+   *
+   * @param h Slot of the process
+   * @return true if the starttime is unchanged
+   * @return false if the process exited or the pid was reused
+   */
+  bool is_same_process_(PidTable::Handle h);
+
+  /**
+   * @brief Sends SIGSTOP to a process and marks it as self stopped, or
+   * forgets it if it no longer exists
+   *
+   * @param h Slot of the process
+   */
+  void stop_pid_(PidTable::Handle h);
+
+  /**
+   * @brief Places an updated process in stop_candidates_ or stopped_heap_
+   * (or neither) and refreshes its cpu usage key
+   *
+   * @param h Slot of the updated process
+   */
+  void track_pid_(PidTable::Handle h);
+
+  /** @brief Drops continued processes from self_stopped_pids_ */
+  void prune_self_stopped_();
+
+ public:
+  /**
+   * @brief Construct a new PidLimiter object
+   *
+   * @param cfg Shared pointer to the execution configuration
+   * @param out Shared pointer to the execution logger
+   */
+  PidLimiter(const std::shared_ptr<Config> &cfg,
+             const std::shared_ptr<Logger> &out);
+
+  /** @brief Destroy the PidLimiter object, continuing every stopped pid */
+  ~PidLimiter();
+
+  PidLimiter(const PidLimiter &) = delete;
+  PidLimiter &operator=(const PidLimiter &) = delete;
+
+  void update() override;
+  void refresh_limited() override;
+  void forget() override;
+  void reload_whitelist() override;
+  bool limit_next() override;
+  bool limit_all() override;
+  bool release_next() override;
+  bool release_all() override;
+  size_t limited_count() const override;
+  u_long scanned() const override;
+  u_long signals() const override;
+  u_long whitelist_checks() const override;
+  std::chrono::nanoseconds whitelist_time() const override;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
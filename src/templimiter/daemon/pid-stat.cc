@@ -0,0 +1,128 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file pid-stat.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidStat struct and its parser
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/pid-stat.h"
+
+#include <charconv>
+#include <string_view>
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief Walks the space-separated fields after the comm field */
+class FieldCursor {
+ private:
+  /** @brief Current position */
+  const char *cur_;
+
+  /** @brief End of the stat contents */
+  const char *end_;
+
+ public:
+  FieldCursor(const char *begin, const char *end) : cur_(begin), end_(end) {}
+
+  /**
+   * @brief Parses the next field as an integer
+   *
+   * @tparam T Integer type
+   * @param out Parsed value
+   * @return true if parsed
+   * @return false if the field is missing or malformed
+   */
+  template <typename T>
+  bool next(T &out) {
+    if (cur_ >= end_ || *cur_ != ' ') return false;
+    cur_++;
+    auto result = std::from_chars(cur_, end_, out);
+    if (result.ec != std::errc()) return false;
+    cur_ = result.ptr;
+    return true;
+  }
+
+  /**
+   * @brief Parses the next field as a single character
+   *
+   * @param out Parsed value
+   * @return true if parsed
+   * @return false if the field is missing
+   */
+  bool next(char &out) {
+    if (end_ - cur_ < 2 || cur_[0] != ' ') return false;
+    out = cur_[1];
+    cur_ += 2;
+    return true;
+  }
+
+  /**
+   * @brief Skips the next n fields
+   *
+   * @param n Number of fields to skip
+   * @return true if skipped
+   * @return false if there are not enough fields
+   */
+  bool skip(size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      if (cur_ >= end_ || *cur_ != ' ') return false;
+      cur_++;
+      while (cur_ < end_ && *cur_ != ' ') cur_++;
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+bool parse_pid_stat(std::string_view stat, PidStat &out) {
+  size_t comm_begin = stat.find('(');
+  size_t comm_end = stat.rfind(')');
+  if (comm_begin == std::string_view::npos ||
+      comm_end == std::string_view::npos || comm_end < comm_begin) {
+    return false;
+  }
+  out.comm = stat.substr(comm_begin, comm_end - comm_begin + 1);
+
+  // Fields 3 onward (state, ppid, ...) follow the closing parenthesis
+  FieldCursor fields(stat.data() + comm_end + 1, stat.data() + stat.size());
+  if (!fields.next(out.state) || !fields.next(out.ppid) ||
+      !fields.next(out.pgrp) || !fields.next(out.session) ||
+      !fields.next(out.tty_nr) || !fields.next(out.tpgid) ||
+      !fields.next(out.flags)) {
+    return false;
+  }
+  // Skip minflt, cminflt, majflt, and cmajflt
+  if (!fields.skip(4) || !fields.next(out.utime) || !fields.next(out.stime) ||
+      !fields.next(out.cutime) || !fields.next(out.cstime)) {
+    return false;
+  }
+  // Skip priority, then num_threads and itrealvalue
+  return fields.skip(1) && fields.next(out.nice) && fields.skip(2) &&
+         fields.next(out.starttime);
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
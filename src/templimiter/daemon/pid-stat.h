@@ -0,0 +1,82 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file pid-stat.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidStat struct and its parser
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string_view>
+
+namespace templimiter {
+
+namespace daemon {
+
+/** @brief Fields of a /proc/<pid>/stat file used by templimiter */
+struct PidStat {
+  /** @brief comm value, including the surrounding parentheses */
+  std::string_view comm;
+  /** @brief state value */
+  char state;
+  /** @brief ppid value */
+  pid_t ppid;
+  /** @brief pgrp value */
+  int pgrp;
+  /** @brief session value */
+  int session;
+  /** @brief tty_nr value */
+  int tty_nr;
+  /** @brief tpgid value */
+  int tpgid;
+  /** @brief flags value */
+  uint flags;
+  /** @brief utime value */
+  u_long utime;
+  /** @brief stime value */
+  u_long stime;
+  /** @brief cutime value */
+  u_long cutime;
+  /** @brief cstime value */
+  u_long cstime;
+  /** @brief nice value */
+  long nice;
+  /** @brief starttime value (distinguishes processes that reuse a pid) */
+  unsigned long long starttime;
+};
+
+/**
+ * @brief Parses the contents of a /proc/<pid>/stat file without allocating
+ *
+ * The comm field is located using the first '(' and the last ')' so that
+ * names containing spaces or parentheses are parsed correctly. The comm view
+ * refers to the provided stat contents.
+ *
+ * @param stat Contents of the stat file
+ * @param out Parsed fields
+ * @return true if the contents were parsed
+ * @return false if the contents are malformed
+ */
+bool parse_pid_stat(std::string_view stat, PidStat &out);
+
+}  // namespace daemon
+
+}  // namespace templimiter
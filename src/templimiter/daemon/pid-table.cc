@@ -0,0 +1,274 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file pid-table.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidTable class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/pid-table.h"
+
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/pid-stat.h"
+#include "templimiter/daemon/system-snapshot.h"
+#include "templimiter/error/internal-error.h"
+#include "templimiter/tools/vector.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+void PidTable::load_(Handle h, const PidStat &stat) {
+  uint8_t &flags = flags_[h];
+  if (stat.starttime != starttimes_[h]) {
+    // The pid now belongs to a different process; start over
+    flags = IN_USE | WHITELIST_STALE;
+    close_pidfd_(h);
+    starttimes_[h] = stat.starttime;
+    pid_times_[h] = 0;
+    cpu_times_[h] = 0;
+    cpu_pcts_[h] = 0;
+  }
+  Attrs &attrs = attrs_[h];
+  Comm &comm = comms_[h];
+  std::string_view new_comm = stat.comm.substr(0, COMM_CAPACITY_);
+  if (stat.state != attrs.state || stat.nice != attrs.nice ||
+      stat.ppid != attrs.ppid || stat.pgrp != attrs.pgrp ||
+      stat.session != attrs.session || stat.tty_nr != attrs.tty_nr ||
+      stat.tpgid != attrs.tpgid || stat.flags != attrs.flags ||
+      new_comm != std::string_view(comm.data, comm.size)) {
+    flags |= WHITELIST_STALE;
+    attrs = Attrs{stat.state,  stat.ppid,  stat.pgrp,  stat.session,
+                  stat.tty_nr, stat.tpgid, stat.flags, stat.nice};
+    std::memcpy(comm.data, new_comm.data(), new_comm.size());
+    comm.size = uint8_t(new_comm.size());
+  }
+}
+
+void PidTable::check_whitelist_(Handle h) {
+  uint8_t &flags = flags_[h];
+  if (!(flags & WHITELIST_STALE)) return;
+  flags &= uint8_t(~WHITELIST_STALE);
+  const Attrs &attrs = attrs_[h];
+  // assign reuses the existing capacity of comm_scratch_
+  comm_scratch_.assign(comms_[h].data, comms_[h].size);
+  // The clock is only read when the time is published
+  std::chrono::steady_clock::time_point begin;
+  if (is_timed_) begin = std::chrono::steady_clock::now();
+  bool is_match = cfg_->whitelist().matches(
+      pids_[h], comm_scratch_, attrs.state, attrs.ppid, attrs.pgrp,
+      attrs.session, attrs.tty_nr, attrs.tpgid, attrs.flags, attrs.nice);
+  whitelist_checks_++;
+  if (is_timed_) whitelist_time_ += std::chrono::steady_clock::now() - begin;
+  if (is_match) {
+    flags |= WHITELISTED;
+  } else {
+    flags &= uint8_t(~WHITELISTED);
+  }
+}
+
+void PidTable::close_pidfd_(Handle h) {
+  if (pidfds_[h] != -1) {
+    ::close(pidfds_[h]);
+    pidfds_[h] = -1;
+  }
+}
+
+bool PidTable::signal_(Handle h, int sig) {
+#ifdef SYS_pidfd_send_signal
+  if (pidfds_[h] != -1) {
+    return ::syscall(SYS_pidfd_send_signal, pidfds_[h], sig, nullptr, 0) ==
+               0 ||
+           errno != ESRCH;
+  }
+#endif
+  return ::kill(pids_[h], sig) == 0 || errno != ESRCH;
+}
+
+PidTable::PidTable(const std::shared_ptr<Config> &cfg)
+    : cfg_(cfg), is_timed_(!cfg->stats_file_path().empty()) {}
+
+PidTable::~PidTable() {
+  for_each([this](Handle h) { close_pidfd_(h); });
+}
+
+PidTable::Handle PidTable::find(pid_t pid) const {
+  auto found = handles_.find(pid);
+  return found == handles_.end() ? NONE : found->second;
+}
+
+PidTable::Handle PidTable::insert(pid_t pid, const PidStat &stat,
+                                  u_long generation) {
+  Handle h;
+  if (free_.empty()) {
+    h = Handle(pids_.size());
+    pids_.push_back(pid);
+    flags_.push_back(0);
+    starttimes_.push_back(0);
+    pid_times_.push_back(0);
+    cpu_times_.push_back(0);
+    cpu_pcts_.push_back(0);
+    seen_.push_back(0);
+    pidfds_.push_back(-1);
+    attrs_.emplace_back();
+    comms_.emplace_back();
+  } else {
+    h = free_.back();
+    free_.pop_back();
+    pids_[h] = pid;
+  }
+  handles_.emplace(pid, h);
+  // Differs from stat.starttime, so load_ initializes every field
+  starttimes_[h] = ~stat.starttime;
+  load_(h, stat);
+  check_whitelist_(h);
+  seen_[h] = generation;
+  return h;
+}
+
+void PidTable::update(Handle h, const PidStat &stat,
+                      const SystemSnapshot &snapshot, u_long generation) {
+  load_(h, stat);
+  seen_[h] = generation;
+  check_whitelist_(h);
+  uint8_t &flags = flags_[h];
+  if (flags & WHITELISTED) {
+    pid_times_[h] = 0;
+    cpu_times_[h] = 0;
+    cpu_pcts_[h] = 0;
+    flags &= uint8_t(~SAMPLED);
+    return;
+  }
+  u_long cpu_time = snapshot.total_jiffies();
+  u_long pid_time = stat.utime + stat.stime + stat.cutime + stat.cstime;
+  if (flags & SAMPLED) {
+    float pid_time_diff = pid_time - pid_times_[h];
+    float cpu_time_diff = cpu_time - cpu_times_[h];
+    cpu_pcts_[h] = pid_time_diff / cpu_time_diff;
+    flags |= READY;
+  }
+  pid_times_[h] = pid_time;
+  cpu_times_[h] = cpu_time;
+  flags |= SAMPLED;
+}
+
+void PidTable::erase(Handle h) {
+  close_pidfd_(h);
+  handles_.erase(pids_[h]);
+  flags_[h] = 0;
+  comms_[h].size = 0;
+  free_.push_back(h);
+}
+
+void PidTable::clear() {
+  for_each([this](Handle h) { close_pidfd_(h); });
+  tools::free_memory(pids_);
+  tools::free_memory(flags_);
+  tools::free_memory(starttimes_);
+  tools::free_memory(pid_times_);
+  tools::free_memory(cpu_times_);
+  tools::free_memory(cpu_pcts_);
+  tools::free_memory(seen_);
+  tools::free_memory(pidfds_);
+  tools::free_memory(attrs_);
+  tools::free_memory(comms_);
+  tools::free_memory(free_);
+  tools::free_memory(handles_);
+}
+
+void PidTable::recheck_whitelist() {
+  for_each([this](Handle h) {
+    flags_[h] |= WHITELIST_STALE;
+    check_whitelist_(h);
+  });
+}
+
+u_long PidTable::whitelist_checks() const { return whitelist_checks_; }
+std::chrono::nanoseconds PidTable::whitelist_time() const {
+  return whitelist_time_;
+}
+
+size_t PidTable::size() const { return handles_.size(); }
+size_t PidTable::capacity() const { return pids_.size(); }
+pid_t PidTable::pid(Handle h) const { return pids_[h]; }
+std::string_view PidTable::comm(Handle h) const {
+  return std::string_view(comms_[h].data, comms_[h].size);
+}
+u_long PidTable::seen(Handle h) const { return seen_[h]; }
+int PidTable::pidfd(Handle h) const { return pidfds_[h]; }
+unsigned long long PidTable::starttime(Handle h) const {
+  return starttimes_[h];
+}
+bool PidTable::is_whitelisted(Handle h) const {
+  return flags_[h] & WHITELISTED;
+}
+bool PidTable::is_ready(Handle h) const { return flags_[h] & READY; }
+bool PidTable::is_self_stopped(Handle h) const {
+  return flags_[h] & SELF_STOPPED;
+}
+float PidTable::cpu_pct(Handle h) const {
+  if (!(flags_[h] & READY)) {
+    throw error::InternalError(
+        "Attempted to access cpu_pct before cpu_pct was calculated.");
+  }
+  return cpu_pcts_[h];
+}
+
+bool PidTable::open_pidfd(Handle h) {
+#ifdef SYS_pidfd_open
+  // Falls back to kill on kernels without pidfd support
+  if (pidfds_[h] == -1) {
+    pidfds_[h] = int(::syscall(SYS_pidfd_open, pids_[h], 0));
+    return pidfds_[h] != -1;
+  }
+#endif
+  return false;
+}
+
+bool PidTable::send_SIGSTOP(Handle h) {
+  if (!signal_(h, SIGSTOP)) {
+    close_pidfd_(h);
+    return false;
+  }
+  flags_[h] |= SELF_STOPPED;
+  return true;
+}
+
+void PidTable::send_SIGCONT(Handle h) {
+  // The pidfd stays open, so that stopping the process again neither races
+  // with pid reuse nor loses its exit events
+  signal_(h, SIGCONT);
+  flags_[h] &= uint8_t(~SELF_STOPPED);
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
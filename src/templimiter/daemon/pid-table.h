@@ -0,0 +1,394 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file pid-table.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::PidTable class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/pid-stat.h"
+#include "templimiter/daemon/system-snapshot.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Pooled structure-of-arrays table of the processes tracked by
+ * SIGSTOP mode: reads information, calculates cpu usage, and sends signals
+ *
+ * Every process occupies one slot, named by a Handle, across parallel
+ * arrays; the fields read on every update sit in their own arrays and the
+ * whitelist inputs and comm (stored inline) in colder ones. Slots of
+ * removed processes are reused, so memory stays flat once the table has
+ * grown to the size of the process table.
+ */
+class PidTable {
+ public:
+  /** @brief Index of a slot */
+  using Handle = uint32_t;
+
+  /** @brief Handle of no slot */
+  static constexpr Handle NONE = UINT32_MAX;
+
+ private:
+  /** @brief Largest comm stored, including its parentheses */
+  static constexpr size_t COMM_CAPACITY_ = 64;
+
+  /** @brief Bits of flags_ */
+  enum Flag : uint8_t {
+    /** @brief The slot holds a process */
+    IN_USE = 1 << 0,
+    /** @brief The process is whitelisted */
+    WHITELISTED = 1 << 1,
+    /** @brief A whitelist input has changed since the last check */
+    WHITELIST_STALE = 1 << 2,
+    /** @brief The process has received its first cpu time sample */
+    SAMPLED = 1 << 3,
+    /** @brief The process has calculated its first cpu usage */
+    READY = 1 << 4,
+    /** @brief The process has been sent SIGSTOP */
+    SELF_STOPPED = 1 << 5
+  };
+
+  /** @brief Stat fields that the whitelist depends on */
+  struct Attrs {
+    /** @brief state value */
+    char state;
+    /** @brief ppid value */
+    pid_t ppid;
+    /** @brief pgrp value */
+    int pgrp;
+    /** @brief session value */
+    int session;
+    /** @brief tty_nr value */
+    int tty_nr;
+    /** @brief tpgid value */
+    int tpgid;
+    /** @brief flags value */
+    uint flags;
+    /** @brief nice value */
+    long nice;
+  };
+
+  /** @brief Inline comm storage */
+  struct Comm {
+    /** @brief Number of bytes used */
+    uint8_t size;
+    /** @brief comm value, including the surrounding parentheses */
+    char data[COMM_CAPACITY_];
+  };
+
+  /** @brief Execution configuration */
+  std::shared_ptr<Config> cfg_;
+
+  /** @brief Pid of each slot */
+  std::vector<pid_t> pids_;
+
+  /** @brief Flag bits of each slot */
+  std::vector<uint8_t> flags_;
+
+  /** @brief starttime of each slot (distinguishes reused pids) */
+  std::vector<unsigned long long> starttimes_;
+
+  /** @brief Cumulative process jiffies at the last sample */
+  std::vector<u_long> pid_times_;
+
+  /** @brief Total cpu jiffies at the last sample */
+  std::vector<u_long> cpu_times_;
+
+  /** @brief Calculated cpu usage of each slot */
+  std::vector<float> cpu_pcts_;
+
+  /** @brief Scan generation in which each slot was last found */
+  std::vector<u_long> seen_;
+
+  /** @brief Process descriptor held from the first SIGSTOP on, or -1 */
+  std::vector<int> pidfds_;
+
+  /** @brief Whitelist inputs of each slot */
+  std::vector<Attrs> attrs_;
+
+  /** @brief comm of each slot */
+  std::vector<Comm> comms_;
+
+  /** @brief Unused slots */
+  std::vector<Handle> free_;
+
+  /** @brief Slot of each tracked pid */
+  std::unordered_map<pid_t, Handle> handles_;
+
+  /** @brief Reusable comm passed to the whitelist */
+  std::string comm_scratch_;
+
+  /** @brief Whether or not whitelist checks are timed (stats are enabled) */
+  bool is_timed_;
+
+  /** @brief Number of whitelist checks since construction */
+  u_long whitelist_checks_ = 0;
+
+  /** @brief Time spent in whitelist checks (zero unless timed) */
+  std::chrono::nanoseconds whitelist_time_{0};
+
+  /**
+   * @brief Loads parsed stat fields into a slot, flagging whitelist changes
+   * and resetting cpu tracking if the pid has been reused by a new process
+   *
+   * @param h Slot
+   * @param stat Parsed fields of the /proc/<pid>/stat file
+   */
+  void load_(Handle h, const PidStat &stat);
+
+  /**
+   * @brief Checks a slot against the whitelist if any of its inputs have
+   * changed since the last check
+   *
+   * @param h Slot
+   */
+  void check_whitelist_(Handle h);
+
+  /**
+   * @brief Closes the process descriptor of a slot, if open
+   *
+   * @param h Slot
+   */
+  void close_pidfd_(Handle h);
+
+  /**
+   * @brief Sends a signal through the slot's pidfd, or by pid if no
+   * descriptor is open
+   *
+   * @param h Slot
+   * @param sig Signal to send
+   * @return true if sent
+   * @return false if the process no longer exists
+   */
+  bool signal_(Handle h, int sig);
+
+ public:
+  /**
+   * @brief Construct a new PidTable object
+   *
+   * @param cfg Execution configuration
+   */
+  explicit PidTable(const std::shared_ptr<Config> &cfg);
+
+  /** @brief Destroy the PidTable object, closing every process descriptor */
+  ~PidTable();
+
+  PidTable(const PidTable &) = delete;
+  PidTable &operator=(const PidTable &) = delete;
+
+  /**
+   * @brief Returns the slot of a pid
+   *
+   * @param pid Pid to find
+   * @return Handle NONE if the pid is not tracked
+   */
+  Handle find(pid_t pid) const;
+
+  /**
+   * @brief Starts tracking a process and checks it against the whitelist;
+   * its cpu usage is sampled from the next update on
+   *
+   * @param pid Pid of the process (must not be tracked)
+   * @param stat Parsed fields of the /proc/<pid>/stat file
+   * @param generation Current scan generation
+   * @return Handle
+   */
+  Handle insert(pid_t pid, const PidStat &stat, u_long generation);
+
+  /**
+   * @brief Updates a process with new stat and cpu time information
+   *
+   * @param h Slot
+   * @param stat Parsed fields of the /proc/<pid>/stat file
+   * @param snapshot Cpu time information read once for the current iteration
+   * @param generation Current scan generation
+   */
+  void update(Handle h, const PidStat &stat, const SystemSnapshot &snapshot,
+              u_long generation);
+
+  /**
+   * @brief Stops tracking a process and frees its slot for reuse
+   *
+   * @param h Slot
+   */
+  void erase(Handle h);
+
+  /** @brief Stops tracking every process and frees the table's storage */
+  void clear();
+
+  /**
+   * @brief Checks every process against the whitelist again, for use after
+   * the whitelist has been replaced
+   */
+  void recheck_whitelist();
+
+  /**
+   * @brief Returns the number of whitelist checks since construction
+   * @return u_long
+   */
+  u_long whitelist_checks() const;
+
+  /**
+   * @brief Returns the time spent in whitelist checks
+   * @return std::chrono::nanoseconds zero unless stats_file_path is set
+   */
+  std::chrono::nanoseconds whitelist_time() const;
+
+  /**
+   * @brief Returns the number of tracked processes
+   * @return size_t
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns the number of slots, used or not; every Handle is below
+   * it
+   * @return size_t
+   */
+  size_t capacity() const;
+
+  /**
+   * @brief Calls a function with the Handle of every tracked process
+   *
+   * @tparam F Function type
+   * @param fn Function called with each Handle; it may erase that Handle
+   */
+  template <typename F>
+  void for_each(F fn) {
+    for (Handle h = 0; h < Handle(pids_.size()); h++) {
+      if (flags_[h] & IN_USE) fn(h);
+    }
+  }
+
+  /**
+   * @brief Returns the pid of a slot
+   * @param h Slot
+   * @return pid_t
+   */
+  pid_t pid(Handle h) const;
+
+  /**
+   * @brief Returns the comm of a slot
+   * @param h Slot
+   * @return std::string_view
+   */
+  std::string_view comm(Handle h) const;
+
+  /**
+   * @brief Returns the scan generation in which a slot was last found
+   * @param h Slot
+   * @return u_long
+   */
+  u_long seen(Handle h) const;
+
+  /**
+   * @brief Returns the process descriptor held since the first SIGSTOP
+   * @param h Slot
+   * @return int Descriptor, or -1 if none is held
+   */
+  int pidfd(Handle h) const;
+
+  /**
+   * @brief Returns the starttime that the slot was last loaded with
+   * @param h Slot
+   * @return unsigned long long
+   */
+  unsigned long long starttime(Handle h) const;
+
+  /**
+   * @brief Returns whether or not a process is whitelisted
+   * @param h Slot
+   * @return true if whitelisted
+   * @return false if not whitelisted
+   */
+  bool is_whitelisted(Handle h) const;
+
+  /**
+   * @brief Returns whether or not a process has calculated its first cpu
+   * usage
+   * @param h Slot
+   * @return true if calculated
+   * @return false if not calculated
+   */
+  bool is_ready(Handle h) const;
+
+  /**
+   * @brief Returns whether or not a process was stopped from within
+   * @param h Slot
+   * @return true if stopped from within
+   * @return false if not stopped from within
+   */
+  bool is_self_stopped(Handle h) const;
+
+  /**
+   * @brief Returns the calculated cpu usage of a slot
+   *
+   * @param h Slot
+   * @return float
+   * @throw templimiter::error::InternalError if the process is not ready
+   */
+  float cpu_pct(Handle h) const;
+
+  /**
+   * @brief Opens a process descriptor, so that later signals cannot reach a
+   * process reusing the pid; kept until the slot is erased or reused
+   *
+   * @param h Slot
+   * @return true if a descriptor was opened by this call; it refers to
+   * whichever process held the pid at the time, so the caller must verify
+   * its starttime
+   * @return false if one was already open or pidfds are not supported
+   */
+  bool open_pidfd(Handle h);
+
+  /**
+   * @brief Sends a SIGSTOP signal to a process, through its pidfd if open
+   *
+   * @param h Slot
+   * @return true if the process was stopped
+   * @return false if the process no longer exists
+   */
+  bool send_SIGSTOP(Handle h);
+
+  /**
+   * @brief Sends a SIGCONT signal to a process; keeps its pidfd open
+   *
+   * @param h Slot
+   */
+  void send_SIGCONT(Handle h);
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
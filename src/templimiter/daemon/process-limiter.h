@@ -0,0 +1,136 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file process-limiter.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ProcessLimiter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Interface of a SIGSTOP mode backend: the lever that stops or
+ * restricts the highest-consuming work while too hot (single processes,
+ * whole cgroups)
+ */
+class ProcessLimiter {
+ public:
+  virtual ~ProcessLimiter() = default;
+
+  /** @brief Remeasures everything that may be limited */
+  virtual void update() = 0;
+
+  /**
+   * @brief Refreshes what is currently limited before a release; may be
+   * cheaper than update()
+   */
+  virtual void refresh_limited() = 0;
+
+  /**
+   * @brief Drops every measurement and frees its memory, unless anything is
+   * limited; the next update() starts measuring from scratch
+   */
+  virtual void forget() = 0;
+
+  /**
+   * @brief Rechecks every measured process against the whitelist after the
+   * configuration has been reloaded; limited processes stay limited
+   */
+  virtual void reload_whitelist() = 0;
+
+  /**
+   * @brief Limits the highest-consuming candidate by one step
+   *
+   * @return true if anything was limited
+   * @return false if nothing could be limited
+   */
+  virtual bool limit_next() = 0;
+
+  /**
+   * @brief Limits every candidate fully
+   *
+   * @return true if anything was limited
+   * @return false if nothing could be limited
+   */
+  virtual bool limit_all() = 0;
+
+  /**
+   * @brief Releases the lowest-consuming limited candidate by one step
+   *
+   * @return true if anything was released
+   * @return false if nothing is limited
+   */
+  virtual bool release_next() = 0;
+
+  /**
+   * @brief Releases everything that is limited
+   *
+   * @return true if anything was released
+   * @return false if nothing is limited
+   */
+  virtual bool release_all() = 0;
+
+  /**
+   * @brief Returns the number of candidates currently limited
+   *
+   * @return size_t
+   */
+  virtual size_t limited_count() const = 0;
+
+  /**
+   * @brief Returns the number of candidates measured since construction
+   *
+   * @return u_long
+   */
+  virtual u_long scanned() const = 0;
+
+  /**
+   * @brief Returns the number of signals sent or limits written since
+   * construction
+   *
+   * @return u_long
+   */
+  virtual u_long signals() const = 0;
+
+  /**
+   * @brief Returns the number of whitelist checks since construction
+   *
+   * @return u_long
+   */
+  virtual u_long whitelist_checks() const = 0;
+
+  /**
+   * @brief Returns the time spent in whitelist checks since construction
+   *
+   * @return std::chrono::nanoseconds zero unless stats_file_path is set
+   */
+  virtual std::chrono::nanoseconds whitelist_time() const = 0;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
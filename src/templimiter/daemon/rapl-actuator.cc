@@ -0,0 +1,350 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file rapl-actuator.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::RaplActuator class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/rapl-actuator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/frequency-ladder.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/error/config-error.h"
+#include "templimiter/error/error.h"
+#include "templimiter/error/io-error.h"
+#include "templimiter/io/file-collection.h"
+#include "templimiter/io/file.h"
+#include "templimiter/io/operations.h"
+#include "templimiter/tools/type-convert.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief Name prefix of RAPL package zones (subzones are core, uncore...) */
+const std::string PACKAGE_PREFIX = "package-";
+
+/** @brief First line of the state file; changes with its format */
+const std::string STATE_HEADER = "templimiter-rapl 1";
+
+/**
+ * @brief Reads the first line of a file next to a zone's limit file
+ *
+ * @param limit_path Location of the zone's limit file
+ * @param name File name within the zone directory
+ * @return std::string Empty if the file does not exist
+ */
+std::string read_zone_file(const std::string &limit_path,
+                           const std::string &name) {
+  std::string path = limit_path.substr(0, limit_path.rfind('/') + 1) + name;
+  if (!io::file_exists(path)) return "";
+  io::File<std::string> file(path);
+  const auto &lines = file.read();
+  return lines.size() > 0 ? lines[0] : "";
+}
+
+}  // namespace
+
+bool RaplActuator::is_in_domain_(const Zone &zone,
+                                 const ThermalDomain &domain) {
+  return domain.package == -1 || zone.package == domain.package;
+}
+
+const std::vector<u_long> &RaplActuator::cur_limits_of_pass_() {
+  if (!cur_limits_) cur_limits_ = &limit_files_->read();
+  return *cur_limits_;
+}
+
+bool RaplActuator::is_zone_expected_(size_t i) {
+  if (cur_limits_of_pass_()[i] != expected_limits_[i]) {
+    found_unexpected_ = true;
+    return false;
+  }
+  return true;
+}
+
+void RaplActuator::set_zone_limit_(size_t i,
+                                   const FrequencyLadder::Position &pos) {
+  u_long limit = zones_[i].ladder.at(pos);
+  if (limit != expected_limits_[i]) {
+    pending_indices_.push_back(i);
+    pending_limits_.push_back(limit);
+  }
+  expected_limits_[i] = limit;
+  zones_[i].pos = pos;
+}
+
+void RaplActuator::sample_energy_() {
+  if (!energy_files_) return;
+  auto now = std::chrono::steady_clock::now();
+  const auto &energies = energy_files_->read();
+  for (size_t i = 0; i < zones_.size() && i < energies.size(); i++) {
+    Zone &zone = zones_[i];
+    if (zone.has_energy) {
+      double elapsed =
+          std::chrono::duration<double>(now - zone.last_time).count();
+      // The counter wraps at max_energy_range_uj
+      bool wrapped = energies[i] < zone.last_energy;
+      if (elapsed > 0 && (!wrapped || zone.max_energy_range > 0)) {
+        u_long used =
+            wrapped ? zone.max_energy_range - zone.last_energy + energies[i]
+                    : energies[i] - zone.last_energy;
+        zone.power = u_long(double(used) / elapsed);
+      }
+    }
+    zone.has_energy = true;
+    zone.last_energy = energies[i];
+    zone.last_time = now;
+  }
+}
+
+std::vector<u_long> RaplActuator::load_state_(
+    const std::vector<std::string> &limit_paths) const {
+  std::ifstream in(state_path_);
+  std::string line;
+  if (!std::getline(in, line) || line != STATE_HEADER) return {};
+  std::vector<u_long> limits;
+  try {
+    // One "path limit" line per zone, in the order of limit_paths
+    for (const auto &path : limit_paths) {
+      if (!std::getline(in, line)) return {};
+      size_t sep = line.rfind(' ');
+      if (sep == std::string::npos || line.substr(0, sep) != path) return {};
+      limits.push_back(tools::convert<u_long>(line.substr(sep + 1)));
+    }
+  } catch (const error::Error &) {
+    return {};
+  }
+  if (std::getline(in, line)) return {};
+  return limits;
+}
+
+void RaplActuator::store_state_(
+    const std::vector<std::string> &limit_paths) const {
+  std::ostringstream out;
+  out << STATE_HEADER << '\n';
+  for (size_t i = 0; i < limit_paths.size(); i++) {
+    out << limit_paths[i] << ' ' << original_limits_[i] << '\n';
+  }
+  if (!io::replace_file(state_path_, out.str())) {
+    throw error::IOError(state_path_, "write");
+  }
+}
+
+RaplActuator::RaplActuator(const std::shared_ptr<Config> &cfg)
+    : cfg_(cfg), state_path_(cfg->rapl_state_path()) {
+  // Keep package zones only; subzones are limited through their package
+  std::vector<std::string> limit_paths;
+  std::vector<std::string> energy_paths;
+  std::vector<int> packages;
+  for (const auto &path : io::ls(cfg_->matcher_rapl())) {
+    std::string name = read_zone_file(path, "name");
+    if (name.compare(0, PACKAGE_PREFIX.size(), PACKAGE_PREFIX) != 0) continue;
+    try {
+      packages.push_back(
+          tools::convert<int>(name.substr(PACKAGE_PREFIX.size())));
+    } catch (const error::Error &) {
+      continue;
+    }
+    limit_paths.push_back(path);
+    energy_paths.push_back(path.substr(0, path.rfind('/') + 1) + "energy_uj");
+  }
+  if (limit_paths.empty()) {
+    throw error::ConfigError("matcher_rapl", cfg_->matcher_rapl(),
+                             "No RAPL package zones found.");
+  }
+  limit_files_ =
+      std::make_shared<io::FileCollection<u_long>>(limit_paths, true);
+  try {
+    energy_files_ =
+        std::make_shared<io::FileCollection<u_long>>(energy_paths, true);
+    energy_files_->read();
+  } catch (const error::Error &) {
+    // Without energy counters, throttling steps from the limit itself
+    energy_files_.reset();
+  }
+
+  // The limits found before any throttling are the highest steps. A daemon
+  // that crashed may have left them lowered, so a previous run's originals
+  // win over the limits found now.
+  expected_limits_ = limit_files_->read();
+  if (state_path_ != "") {
+    original_limits_ = load_state_(limit_paths);
+  }
+  if (original_limits_.empty()) {
+    original_limits_ = expected_limits_;
+    if (state_path_ != "") store_state_(limit_paths);
+  }
+  uint steps = cfg_->rapl_step_count();
+  for (size_t i = 0; i < limit_paths.size(); i++) {
+    u_long max = original_limits_[i];
+    u_long min = max / 100 * cfg_->rapl_min_power_pct();
+    std::vector<u_long> limits;
+    for (uint s = 0; s < steps; s++) {
+      limits.push_back(min + (max - min) / steps * s);
+    }
+    limits.push_back(max);
+    u_long max_energy_range = 0;
+    try {
+      max_energy_range = tools::convert<u_long>(
+          read_zone_file(limit_paths[i], "max_energy_range_uj"));
+    } catch (const error::Error &) {
+      // A zero range never accepts a wrapped sample
+    }
+    FrequencyLadder ladder(limits);
+    FrequencyLadder::Position pos = ladder.find(expected_limits_[i]);
+    zones_.push_back(
+        Zone{packages[i], ladder, pos, max_energy_range, false, 0, {}, 0});
+  }
+  sample_energy_();
+}
+
+RaplActuator::~RaplActuator() {
+  // Never leave the package limits lowered behind an exiting daemon
+  try {
+    limit_files_->overwrite_each(original_limits_);
+  } catch (const error::Error &) {
+    // Keep the state file, so that the next start still knows the originals
+    return;
+  }
+  if (state_path_ != "") {
+    std::remove(state_path_.c_str());
+  }
+}
+
+std::string RaplActuator::setting_name() const { return "power limit"; }
+
+void RaplActuator::begin() {
+  cur_limits_ = nullptr;
+  sample_energy_();
+}
+
+bool RaplActuator::is_below_max(const ThermalDomain &domain) {
+  const auto &cur_limits = cur_limits_of_pass_();
+  for (size_t i = 0; i < zones_.size(); i++) {
+    if (is_in_domain_(zones_[i], domain) &&
+        zones_[i].ladder.is_below_max(cur_limits[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RaplActuator::is_above_min(const ThermalDomain &domain) {
+  const auto &cur_limits = cur_limits_of_pass_();
+  for (size_t i = 0; i < zones_.size(); i++) {
+    if (is_in_domain_(zones_[i], domain) &&
+        zones_[i].ladder.is_above_min(cur_limits[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RaplActuator::throttle(const ThermalDomain &domain) {
+  for (size_t i = 0; i < zones_.size(); i++) {
+    Zone &zone = zones_[i];
+    if (!is_in_domain_(zone, domain)) continue;
+    if (!is_zone_expected_(i)) break;
+    FrequencyLadder::Position pos = zone.pos;
+    // A limit above the power drawn is not binding; start below the draw
+    if (zone.power > 0 && zone.power < expected_limits_[i]) {
+      pos = zone.ladder.floor(zone.power);
+    }
+    if (zone.ladder.step_down(pos) || pos.index != zone.pos.index) {
+      set_zone_limit_(i, pos);
+    }
+  }
+}
+
+void RaplActuator::dethrottle(const ThermalDomain &domain) {
+  for (size_t i = 0; i < zones_.size(); i++) {
+    Zone &zone = zones_[i];
+    if (!is_in_domain_(zone, domain)) continue;
+    if (!is_zone_expected_(i)) break;
+    FrequencyLadder::Position pos = zone.pos;
+    if (zone.ladder.step_up(pos)) set_zone_limit_(i, pos);
+  }
+}
+
+int RaplActuator::set_level(const ThermalDomain &domain, double throttle) {
+  int moved = 0;
+  for (size_t i = 0; i < zones_.size(); i++) {
+    Zone &zone = zones_[i];
+    if (!is_in_domain_(zone, domain)) continue;
+    u_long max = zone.ladder.max();
+    u_long target = max - u_long(throttle * double(max - zone.ladder.min()));
+    FrequencyLadder::Position pos = zone.ladder.floor(target);
+    u_long limit = zone.ladder.at(pos);
+    if (limit == expected_limits_[i]) continue;
+    if (!is_zone_expected_(i)) break;
+    moved |= limit < expected_limits_[i] ? LOWERED : RAISED;
+    set_zone_limit_(i, pos);
+  }
+  return moved;
+}
+
+size_t RaplActuator::flush() {
+  size_t written = pending_limits_.size();
+  if (written > 0) {
+    limit_files_->overwrite_each(pending_indices_, pending_limits_);
+  }
+  pending_indices_.clear();
+  pending_limits_.clear();
+  return written;
+}
+
+bool RaplActuator::is_limited() const {
+  for (size_t i = 0; i < zones_.size(); i++) {
+    if (zones_[i].ladder.is_below_max(expected_limits_[i])) return true;
+  }
+  return false;
+}
+
+bool RaplActuator::found_unexpected() const { return found_unexpected_; }
+
+void RaplActuator::resync() {
+  found_unexpected_ = false;
+  expected_limits_ = limit_files_->read();
+  for (size_t i = 0; i < zones_.size(); i++) {
+    zones_[i].pos = zones_[i].ladder.find(expected_limits_[i]);
+  }
+}
+
+const std::vector<u_long> &RaplActuator::settings() const {
+  return expected_limits_;
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,199 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file rapl-actuator.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::RaplActuator class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/frequency-ladder.h"
+#include "templimiter/daemon/thermal-domain.h"
+#include "templimiter/daemon/throttle-actuator.h"
+#include "templimiter/io/file-collection.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Throttle backend that lowers the long term power limit of each RAPL
+ * package zone (powercap sysfs), letting the hardware choose the frequency
+ * mix that fits the budget
+ *
+ * The original limit is the highest step; rapl_step_count even steps lead
+ * down to rapl_min_power_pct percent of it. The original limits are kept in
+ * rapl_state_path until destruction restores them, so that a daemon restarted
+ * after a crash does not take a lowered limit as its ceiling. Package energy
+ * counters are sampled every pass so that throttling starts below the power
+ * actually drawn instead of stepping through limits that are not binding.
+ */
+class RaplActuator : public ThrottleActuator {
+ private:
+  /** @brief A RAPL package zone */
+  struct Zone {
+    /** @brief Package id (from the zone's "package-N" name) */
+    int package;
+    /** @brief Power limit steps (in microwatts) */
+    FrequencyLadder ladder;
+    /** @brief Position of the expected limit on the ladder */
+    FrequencyLadder::Position pos;
+    /** @brief Range of the energy counter before it wraps (in microjoules) */
+    u_long max_energy_range;
+    /** @brief Whether or not a previous energy sample exists */
+    bool has_energy = false;
+    /** @brief Previous energy counter value (in microjoules) */
+    u_long last_energy = 0;
+    /** @brief Time of the previous energy sample */
+    std::chrono::steady_clock::time_point last_time;
+    /** @brief Measured power since the previous sample (in microwatts) */
+    u_long power = 0;
+  };
+
+  /** @brief Shared pointer to the execution configuration */
+  std::shared_ptr<Config> cfg_;
+
+  /** @brief Where the original limits are kept ("" for off) */
+  std::string state_path_;
+
+  /** @brief Package zones, in the order of limit_files_ */
+  std::vector<Zone> zones_;
+
+  /** @brief constraint_0_power_limit_uw file of each zone */
+  std::shared_ptr<io::FileCollection<u_long>> limit_files_;
+
+  /** @brief energy_uj file of each zone (null if unreadable) */
+  std::shared_ptr<io::FileCollection<u_long>> energy_files_;
+
+  /** @brief Power limit of each zone before it was throttled (in microwatts) */
+  std::vector<u_long> original_limits_;
+
+  /** @brief Expected power limit of each zone (in microwatts) */
+  std::vector<u_long> expected_limits_;
+
+  /** @brief Zone indices queued for writing this pass */
+  std::vector<size_t> pending_indices_;
+
+  /** @brief Limits queued for writing this pass */
+  std::vector<u_long> pending_limits_;
+
+  /** @brief Current limits read during this pass (null until needed) */
+  const std::vector<u_long> *cur_limits_ = nullptr;
+
+  /** @brief Whether or not a limit was not as expected */
+  bool found_unexpected_ = false;
+
+  /**
+   * @brief Checks whether or not a zone is throttled with a domain
+   *
+   * @param zone Zone to check
+   * @param domain Thermal domain
+   * @return true if the zone belongs to the domain
+   * @return false otherwise
+   */
+  static bool is_in_domain_(const Zone &zone, const ThermalDomain &domain);
+
+  /**
+   * @brief Returns the current limits, reading them once per pass
+   *
+   * @return const std::vector< u_long >&
+   */
+  const std::vector<u_long> &cur_limits_of_pass_();
+
+  /**
+   * @brief Checks whether or not a zone is at its expected limit, flagging
+   * found_unexpected_ if not
+   *
+   * @param i Zone index
+   * @return true if the limit is as expected
+   * @return false if the limit was modified elsewhere
+   */
+  bool is_zone_expected_(size_t i);
+
+  /**
+   * @brief Sets the expected limit of a zone, queueing a write if it changes
+   *
+   * @param i Zone index
+   * @param pos Ladder position of the new limit
+   */
+  void set_zone_limit_(size_t i, const FrequencyLadder::Position &pos);
+
+  /** @brief Updates the measured power of every zone from energy_uj */
+  void sample_energy_();
+
+  /**
+   * @brief Reads the original limits from state_path_
+   *
+   * @param limit_paths Location of each zone's limit file
+   * @return std::vector< u_long > Empty unless the file lists every zone
+   */
+  std::vector<u_long> load_state_(
+      const std::vector<std::string> &limit_paths) const;
+
+  /**
+   * @brief Writes the original limits to state_path_
+   *
+   * @param limit_paths Location of each zone's limit file
+   * @throw templimiter::error::IOError if state_path_ cannot be written
+   */
+  void store_state_(const std::vector<std::string> &limit_paths) const;
+
+ public:
+  /**
+   * @brief Construct a new RaplActuator object
+   *
+   * @param cfg Shared pointer to the execution configuration
+   * @throw templimiter::error::ConfigError if matcher_rapl finds no package
+   * zones
+   * @throw templimiter::error::IOError if rapl_state_path cannot be written
+   */
+  explicit RaplActuator(const std::shared_ptr<Config> &cfg);
+
+  /** @brief Restores the original limits and removes state_path_ */
+  ~RaplActuator();
+
+  RaplActuator(const RaplActuator &) = delete;
+  RaplActuator &operator=(const RaplActuator &) = delete;
+
+  std::string setting_name() const override;
+  void begin() override;
+  bool is_below_max(const ThermalDomain &domain) override;
+  bool is_above_min(const ThermalDomain &domain) override;
+  void throttle(const ThermalDomain &domain) override;
+  void dethrottle(const ThermalDomain &domain) override;
+  int set_level(const ThermalDomain &domain, double throttle) override;
+  size_t flush() override;
+  bool is_limited() const override;
+  bool found_unexpected() const override;
+  void resync() override;
+  const std::vector<u_long> &settings() const override;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
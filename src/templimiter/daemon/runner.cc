@@ -0,0 +1,91 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file runner.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Runner class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/runner.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <memory>
+
+#include "templimiter/daemon/config-reloader.h"
+#include "templimiter/daemon/config.h"
+#include "templimiter/daemon/monitor.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief Set by the SIGTERM and SIGINT handler, checked between ticks */
+volatile sig_atomic_t stop_signaled = 0;
+
+/** @brief Thread running the control loop */
+pthread_t control_thread;
+
+/**
+ * @brief Records a termination request; a signal taken by a helper thread
+ * is passed on, so that the wait of the control thread also ends early
+ *
+ * @param sig Received signal
+ */
+void on_terminate(int sig) {
+  stop_signaled = 1;
+  if (!::pthread_equal(::pthread_self(), control_thread)) {
+    ::pthread_kill(control_thread, sig);
+  }
+}
+
+}  // namespace
+
+Runner::Runner(const std::shared_ptr<Monitor> &monitor) : monitor_(monitor) {}
+
+Runner::Runner(const std::shared_ptr<Monitor> &monitor,
+               const std::shared_ptr<ConfigReloader> &reloader)
+    : monitor_(monitor), reloader_(reloader) {}
+
+void Runner::run() {
+  control_thread = ::pthread_self();
+  struct sigaction action {};
+  action.sa_handler = on_terminate;
+  ::sigemptyset(&action.sa_mask);
+  // Without SA_RESTART, the signal also ends the current wait early
+  ::sigaction(SIGTERM, &action, nullptr);
+  ::sigaction(SIGINT, &action, nullptr);
+  while (stop_signaled == 0) {
+    u_long max_temp = monitor_->tick();
+    if (reloader_) {
+      // Only adopted between iterations, so each tick sees one configuration
+      std::shared_ptr<Config> next = reloader_->poll();
+      if (next) monitor_->reload(*next);
+    }
+    monitor_->wait(max_temp);
+  }
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
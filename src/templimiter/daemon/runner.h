@@ -0,0 +1,76 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file runner.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Runner class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "templimiter/daemon/config-reloader.h"
+#include "templimiter/daemon/monitor.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Drives a Monitor until SIGTERM or SIGINT is received, so that the
+ * backends are destroyed (and release every response) on a normal stop
+ */
+class Runner {
+ private:
+  /** @brief Shared pointer to the driven monitor */
+  std::shared_ptr<Monitor> monitor_;
+
+  /** @brief Source of reloaded configurations (null to never reload) */
+  std::shared_ptr<ConfigReloader> reloader_;
+
+ public:
+  /**
+   * @brief Construct a new Runner object
+   *
+   * @param monitor Shared pointer to the monitor to drive
+   */
+  explicit Runner(const std::shared_ptr<Monitor> &monitor);
+
+  /**
+   * @brief Construct a new Runner object that applies reloaded
+   * configurations between iterations
+   *
+   * @param monitor Shared pointer to the monitor to drive
+   * @param reloader Shared pointer to the configuration reloader
+   */
+  Runner(const std::shared_ptr<Monitor> &monitor,
+         const std::shared_ptr<ConfigReloader> &reloader);
+
+  /**
+   * @brief Ticks and waits until SIGTERM or SIGINT is received or an error
+   * is thrown; must be called on the thread that constructed the monitor
+   */
+  void run();
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
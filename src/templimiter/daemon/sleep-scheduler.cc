@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file sleep-scheduler.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::SleepScheduler class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/sleep-scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace templimiter {
+
+namespace daemon {
+
+void SleepScheduler::sample_(u_long max_temp) {
+  auto now = std::chrono::steady_clock::now();
+  if (has_sample_) {
+    double elapsed =
+        std::chrono::duration<double, std::milli>(now - last_time_).count();
+    if (elapsed > 0) {
+      double cur_slope = (double(max_temp) - double(last_temp_)) / elapsed;
+      slope_ = SLOPE_WEIGHT_ * cur_slope + (1 - SLOPE_WEIGHT_) * slope_;
+    }
+  }
+  has_sample_ = true;
+  last_temp_ = max_temp;
+  last_time_ = now;
+}
+
+SleepScheduler::SleepScheduler(uint min_sleep, uint max_sleep)
+    : min_sleep_(min_sleep), max_sleep_(max_sleep), interval_(min_sleep) {}
+
+void SleepScheduler::set_bounds(uint min_sleep, uint max_sleep) {
+  min_sleep_ = min_sleep;
+  max_sleep_ = max_sleep;
+  interval_ = std::min(std::max(interval_, min_sleep_), max_sleep_);
+}
+
+uint SleepScheduler::next_interval(u_long max_temp, u_long threshold,
+                                   bool responding) {
+  sample_(max_temp);
+  if (responding || max_temp >= threshold || max_sleep_ <= min_sleep_) {
+    interval_ = min_sleep_;
+    return interval_;
+  }
+
+  // Allow longer intervals the further the temperature is from the threshold
+  u_long headroom = threshold - max_temp;
+  double scale = double(std::min(headroom, BACKOFF_HEADROOM_)) /
+                 double(BACKOFF_HEADROOM_);
+  double ceiling = min_sleep_ + double(max_sleep_ - min_sleep_) * scale;
+
+  if (slope_ > 0) {
+    double crossing = double(headroom) / slope_;
+    if (crossing <= double(interval_)) {
+      // The threshold may be crossed before the next wakeup
+      interval_ = min_sleep_;
+      return interval_;
+    }
+    // Sample at least twice before the predicted crossing
+    ceiling = std::min(ceiling, crossing / 2);
+  }
+
+  // Back off gradually, but shrink immediately
+  uint target = uint(std::max(double(min_sleep_), ceiling));
+  if (target > interval_) {
+    interval_ = std::min(target, std::max(interval_ * 2, 1u));
+  } else {
+    interval_ = target;
+  }
+  return interval_;
+}
+
+uint SleepScheduler::interval() const { return interval_; }
+double SleepScheduler::slope() const { return slope_; }
+
+}  // namespace daemon
+
+}  // namespace templimiter
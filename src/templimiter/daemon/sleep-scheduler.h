@@ -0,0 +1,120 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file sleep-scheduler.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::SleepScheduler class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Chooses the time to wait between iterations from the temperature
+ * slope, backing off toward max_sleep while cool and flat and returning to
+ * min_sleep when a threshold crossing is predicted
+ */
+class SleepScheduler {
+ private:
+  /**
+   * @brief Headroom (in millidegrees) below the threshold at which the full
+   * max_sleep back-off is allowed; smaller headroom scales it down linearly
+   */
+  static constexpr u_long BACKOFF_HEADROOM_ = 10000;
+
+  /** @brief Weight of the newest sample in the smoothed slope */
+  static constexpr double SLOPE_WEIGHT_ = 0.5;
+
+  /** @brief Shortest interval (in milliseconds) */
+  uint min_sleep_;
+
+  /** @brief Longest interval (in milliseconds) */
+  uint max_sleep_;
+
+  /** @brief Current interval (in milliseconds) */
+  uint interval_;
+
+  /** @brief Whether or not a previous sample exists */
+  bool has_sample_ = false;
+
+  /** @brief Temperature of the previous sample */
+  u_long last_temp_ = 0;
+
+  /** @brief Time of the previous sample */
+  std::chrono::steady_clock::time_point last_time_;
+
+  /** @brief Smoothed temperature slope (in millidegrees per millisecond) */
+  double slope_ = 0;
+
+  /**
+   * @brief Adds a temperature sample to the smoothed slope
+   *
+   * @param max_temp Current maximum temperature
+   */
+  void sample_(u_long max_temp);
+
+ public:
+  /**
+   * @brief Construct a new SleepScheduler object
+   *
+   * @param min_sleep Shortest interval (in milliseconds)
+   * @param max_sleep Longest interval (in milliseconds)
+   */
+  SleepScheduler(uint min_sleep, uint max_sleep);
+
+  /**
+   * @brief Changes the interval bounds, keeping the temperature history
+   *
+   * @param min_sleep Shortest interval (in milliseconds)
+   * @param max_sleep Longest interval (in milliseconds)
+   */
+  void set_bounds(uint min_sleep, uint max_sleep);
+
+  /**
+   * @brief Records a temperature sample and returns the next interval
+   *
+   * @param max_temp Current maximum temperature
+   * @param threshold Temperature at which responses may begin
+   * @param responding Whether or not a response is currently active
+   * @return uint Interval (in milliseconds)
+   */
+  uint next_interval(u_long max_temp, u_long threshold, bool responding);
+
+  /**
+   * @brief Returns the current interval
+   * @return uint
+   */
+  uint interval() const;
+
+  /**
+   * @brief Returns the smoothed temperature slope
+   * @return double Millidegrees per millisecond
+   */
+  double slope() const;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,166 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file stat-scan-pool.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::StatScanPool class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/stat-scan-pool.h"
+
+#include <sched.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "templimiter/daemon/pid-stat.h"
+#include "templimiter/io/proc-scanner.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/**
+ * @brief Undoes the isolation that the calling thread inherited from the
+ * control thread, so that workers neither share its cpus nor run as FIFO
+ */
+void leave_control_isolation() {
+  sched_param param{};
+  ::sched_setscheduler(0, SCHED_OTHER, &param);
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  long count = ::sysconf(_SC_NPROCESSORS_CONF);
+  for (long cpu = 0; cpu < count && cpu < CPU_SETSIZE; cpu++) {
+    CPU_SET(cpu, &cpus);
+  }
+  // The kernel leaves out cpus that are offline or outside the cpuset
+  ::sched_setaffinity(0, sizeof(cpus), &cpus);
+}
+
+}  // namespace
+
+void StatScanPool::scan_shard_(Shard &shard) {
+  shard.records.clear();
+  shard.comms.clear();
+  shard.comm_offsets.clear();
+  try {
+    std::string_view stat;
+    PidStat parsed;
+    size_t size = pids_->size();
+    size_t begin;
+    while ((begin = next_chunk_.fetch_add(CHUNK_SIZE_)) < size) {
+      size_t end = std::min(begin + CHUNK_SIZE_, size);
+      for (size_t i = begin; i < end; i++) {
+        pid_t pid = (*pids_)[i];
+        if (!shard.scanner->read_stat(pid, stat) ||
+            !parse_pid_stat(stat, parsed)) {
+          continue;
+        }
+        // comm refers to the scanner's buffer, which the next read reuses
+        shard.comm_offsets.push_back(shard.comms.size());
+        shard.comms.append(parsed.comm);
+        shard.records.push_back(Record{pid, parsed});
+      }
+    }
+    // Point every comm at its copy now that comms no longer grows
+    for (size_t i = 0; i < shard.records.size(); i++) {
+      PidStat &record_stat = shard.records[i].stat;
+      record_stat.comm = std::string_view(
+          shard.comms.data() + shard.comm_offsets[i], record_stat.comm.size());
+    }
+  } catch (...) {
+    shard.records.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) error_ = std::current_exception();
+  }
+}
+
+void StatScanPool::run_(size_t index) {
+  leave_control_isolation();
+  u_long seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+    }
+    scan_shard_(shards_[index]);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--busy_ == 0) done_.notify_one();
+  }
+}
+
+StatScanPool::StatScanPool(const std::string &proc_path, uint thread_count)
+    : shards_(std::max(thread_count, 1u)) {
+  for (auto &shard : shards_) {
+    shard.scanner = std::make_unique<io::ProcScanner>(proc_path);
+  }
+  for (size_t i = 1; i < shards_.size(); i++) {
+    workers_.emplace_back(&StatScanPool::run_, this, i);
+  }
+}
+
+StatScanPool::~StatScanPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+void StatScanPool::scan(const std::vector<pid_t> &pids) {
+  pids_ = &pids;
+  next_chunk_ = 0;
+  if (pids.size() <= CHUNK_SIZE_) {
+    // Not worth waking anyone for a single chunk
+    for (size_t i = 1; i < shards_.size(); i++) shards_[i].records.clear();
+    scan_shard_(shards_[0]);
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      generation_++;
+      busy_ = workers_.size();
+    }
+    wake_.notify_all();
+    scan_shard_(shards_[0]);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return busy_ == 0; });
+  }
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(error, error_);
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,168 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file stat-scan-pool.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::StatScanPool class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "templimiter/daemon/pid-stat.h"
+#include "templimiter/io/proc-scanner.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Reads and parses the stat files of a list of pids on several
+ * threads at once
+ *
+ * The list is split into chunks that the calling thread and the workers
+ * claim from a shared counter until none are left, so a thread slowed down
+ * by the workload simply claims fewer chunks. Each thread parses into its
+ * own buffers; nothing is shared until scan() returns, when the caller
+ * merges every record on its own thread.
+ */
+class StatScanPool {
+ public:
+  /** @brief A parsed stat file */
+  struct Record {
+    /** @brief Pid of the process */
+    pid_t pid;
+    /** @brief Parsed fields (comm refers to the pool's buffers) */
+    PidStat stat;
+  };
+
+ private:
+  /** @brief Number of pids claimed at once */
+  static constexpr size_t CHUNK_SIZE_ = 256;
+
+  /** @brief Buffers owned by one thread */
+  struct Shard {
+    /** @brief Scanner with its own proc directory descriptor */
+    std::unique_ptr<io::ProcScanner> scanner;
+    /** @brief Records parsed this scan */
+    std::vector<Record> records;
+    /** @brief Copies of the comm values of records */
+    std::string comms;
+    /** @brief Offset of the comm value of each record in comms */
+    std::vector<size_t> comm_offsets;
+  };
+
+  /** @brief Buffers of each thread; the first belongs to the caller */
+  std::vector<Shard> shards_;
+
+  /** @brief Worker threads */
+  std::vector<std::thread> workers_;
+
+  /** @brief Pids being scanned */
+  const std::vector<pid_t> *pids_ = nullptr;
+
+  /** @brief Index of the first pid of the next unclaimed chunk */
+  std::atomic<size_t> next_chunk_{0};
+
+  /** @brief Number of scans started (guarded by mutex_) */
+  u_long generation_ = 0;
+
+  /** @brief Number of workers still scanning (guarded by mutex_) */
+  size_t busy_ = 0;
+
+  /** @brief Whether or not the workers should exit (guarded by mutex_) */
+  bool stop_ = false;
+
+  /** @brief First error thrown by a thread this scan (guarded by mutex_) */
+  std::exception_ptr error_;
+
+  /** @brief Guards the scan state */
+  std::mutex mutex_;
+
+  /** @brief Wakes the workers */
+  std::condition_variable wake_;
+
+  /** @brief Wakes the caller once every worker has finished */
+  std::condition_variable done_;
+
+  /**
+   * @brief Claims chunks and parses their stat files until none are left
+   *
+   * @param shard Buffers of the calling thread
+   */
+  void scan_shard_(Shard &shard);
+
+  /**
+   * @brief Worker thread loop; workers run as SCHED_OTHER on every cpu
+   * rather than with the isolation of the control thread
+   *
+   * @param index Index of the worker's shard
+   */
+  void run_(size_t index);
+
+ public:
+  /**
+   * @brief Construct a new StatScanPool object and start its workers
+   *
+   * @param proc_path Location of the proc filesystem
+   * @param thread_count Number of scanning threads, including the caller
+   */
+  StatScanPool(const std::string &proc_path, uint thread_count);
+
+  /** @brief Destroy the StatScanPool object, stopping its workers */
+  ~StatScanPool();
+
+  StatScanPool(const StatScanPool &) = delete;
+  StatScanPool &operator=(const StatScanPool &) = delete;
+
+  /**
+   * @brief Reads and parses the stat file of every pid, returning once all
+   * of them are done; pids that no longer exist are skipped
+   *
+   * @param pids Pids to scan
+   * @throw templimiter::error::IOError if the proc directory cannot be read
+   */
+  void scan(const std::vector<pid_t> &pids);
+
+  /**
+   * @brief Calls a function for every record of the last scan
+   *
+   * @tparam F Function type
+   * @param fn Function called with each const Record &
+   */
+  template <typename F>
+  void for_each(F fn) const {
+    for (const auto &shard : shards_) {
+      for (const auto &record : shard.records) fn(record);
+    }
+  }
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,201 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file stats.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Stats class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/stats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "templimiter/error/io-error.h"
+#include "templimiter/io/operations.h"
+#include "templimiter/tools/type-convert.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief Label of every phase, in Stats::Phase order */
+constexpr const char *PHASE_NAMES[] = {
+    "tick",      "sensor",  "throttle", "write",    "processes",
+    "whitelist", "signals", "logging",  "telemetry"};
+
+/** @brief Metric name and help text of a counter */
+struct CounterInfo {
+  /** @brief Metric name */
+  const char *name;
+  /** @brief Help text */
+  const char *help;
+};
+
+/** @brief Metric of every counter, in Stats::Counter order */
+constexpr CounterInfo COUNTER_INFOS[] = {
+    {"templimiter_ticks_total", "Monitor ticks."},
+    {"templimiter_scanned_total", "Processes or cgroups measured."},
+    {"templimiter_whitelist_checks_total", "Whitelist evaluations."},
+    {"templimiter_signals_total", "Signals sent or cgroup limits written."},
+    {"templimiter_setting_writes_total", "Throttle settings written."},
+    {"templimiter_setting_writes_skipped_total",
+     "Throttle settings left unchanged by a pass."},
+    {"templimiter_log_lines_total", "Log lines written."}};
+
+static_assert(sizeof(PHASE_NAMES) / sizeof(*PHASE_NAMES) == Stats::PHASE_COUNT,
+              "Every phase needs a name.");
+static_assert(sizeof(COUNTER_INFOS) / sizeof(*COUNTER_INFOS) ==
+                  Stats::COUNTER_COUNT,
+              "Every counter needs a metric.");
+
+/**
+ * @brief Formats a number of seconds
+ *
+ * @param seconds Seconds
+ * @return std::string
+ */
+std::string format_seconds(double seconds) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.9g", seconds);
+  return buf;
+}
+
+}  // namespace
+
+Stats::Timer::Timer(Stats *stats, Phase phase)
+    : stats_(stats), phase_(phase) {
+  if (stats_) begin_ = std::chrono::steady_clock::now();
+}
+
+Stats::Timer::~Timer() {
+  if (stats_) {
+    stats_->observe(phase_, std::chrono::steady_clock::now() - begin_);
+  }
+}
+
+std::string Stats::format_() const {
+  std::string text =
+      "# HELP templimiter_phase_duration_seconds Time spent in each part of "
+      "a tick.\n"
+      "# TYPE templimiter_phase_duration_seconds histogram\n";
+  for (size_t p = 0; p < PHASE_COUNT; p++) {
+    const Histogram &hist = phases_[p];
+    std::string label = std::string("{phase=\"") + PHASE_NAMES[p] + "\"";
+    u_long cumulative = 0;
+    for (size_t b = 0; b <= BUCKET_COUNT_; b++) {
+      cumulative += hist.buckets[b].load(std::memory_order_relaxed);
+      std::string le = b < BUCKET_COUNT_
+                           ? format_seconds(double(u_long(1) << b) * 1e-6)
+                           : "+Inf";
+      text += "templimiter_phase_duration_seconds_bucket" + label +
+              ",le=\"" + le + "\"} " + tools::to_string(cumulative) + "\n";
+    }
+    text += "templimiter_phase_duration_seconds_sum" + label + "} " +
+            format_seconds(
+                double(hist.sum_ns.load(std::memory_order_relaxed)) * 1e-9) +
+            "\n";
+    text += "templimiter_phase_duration_seconds_count" + label + "} " +
+            tools::to_string(hist.count.load(std::memory_order_relaxed)) +
+            "\n";
+  }
+  for (size_t c = 0; c < COUNTER_COUNT; c++) {
+    const CounterInfo &info = COUNTER_INFOS[c];
+    text += std::string("# HELP ") + info.name + " " + info.help + "\n" +
+            "# TYPE " + info.name + " counter\n" + info.name + " " +
+            tools::to_string(counters_[c].load(std::memory_order_relaxed)) +
+            "\n";
+  }
+
+  // Syscall counts come from the kernel's task io accounting
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  u_long value;
+  std::string syscalls;
+  while (io >> key >> value) {
+    if (key == "syscr:" || key == "syscw:") {
+      syscalls += std::string("templimiter_syscalls_total{kind=\"") +
+                  (key == "syscr:" ? "read" : "write") + "\"} " +
+                  tools::to_string(value) + "\n";
+    }
+  }
+  if (!syscalls.empty()) {
+    text +=
+        "# HELP templimiter_syscalls_total Read and write syscalls of the "
+        "daemon.\n"
+        "# TYPE templimiter_syscalls_total counter\n" +
+        syscalls;
+  }
+  return text;
+}
+
+Stats::Stats(const std::string &path, uint interval_ms)
+    : path_(path), interval_(interval_ms) {
+  if (!publish()) throw error::IOError(path_, "write");
+}
+
+void Stats::observe(Phase phase, std::chrono::nanoseconds elapsed) {
+  Histogram &hist = phases_[phase];
+  u_long ns = u_long(elapsed.count() > 0 ? elapsed.count() : 0);
+  // Bucket b holds durations up to 2^b microseconds
+  u_long us = (ns + 999) / 1000;
+  size_t bucket = 0;
+  while (bucket < BUCKET_COUNT_ && us > (u_long(1) << bucket)) bucket++;
+  hist.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  hist.count.fetch_add(1, std::memory_order_relaxed);
+  hist.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+}
+
+void Stats::add(Counter counter, u_long n) {
+  counters_[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+void Stats::set(Counter counter, u_long total) {
+  counters_[counter].store(total, std::memory_order_relaxed);
+}
+
+void Stats::observe_total(Phase phase, Counter counter, u_long count_total,
+                          std::chrono::nanoseconds time_total) {
+  if (count_total != counters_[counter].load(std::memory_order_relaxed)) {
+    observe(phase, time_total - last_totals_[phase]);
+    last_totals_[phase] = time_total;
+    set(counter, count_total);
+  }
+}
+
+const std::string &Stats::path() const { return path_; }
+
+bool Stats::publish_if_due() {
+  auto now = std::chrono::steady_clock::now();
+  return now - last_publish_ < interval_ || publish();
+}
+
+bool Stats::publish() {
+  last_publish_ = std::chrono::steady_clock::now();
+  return io::replace_file(path_, format_());
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,236 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file stats.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Stats class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Phase timing histograms and counters of the daemon's own cost,
+ * published as a Prometheus textfile
+ *
+ * Every value is a relaxed atomic, so a reader on another thread never
+ * blocks the tick that records it. Phases may nest: whitelist and logging
+ * time is also part of the phase that triggered it.
+ */
+class Stats {
+ public:
+  /** @brief Timed part of a tick */
+  enum Phase : size_t {
+    /** @brief A whole tick */
+    PHASE_TICK,
+    /** @brief Reading the thermal sensor */
+    PHASE_SENSOR,
+    /** @brief Choosing and applying throttle settings */
+    PHASE_THROTTLE,
+    /** @brief Writing changed throttle settings */
+    PHASE_WRITE,
+    /** @brief Remeasuring processes or cgroups */
+    PHASE_PROCESSES,
+    /** @brief Evaluating the whitelist (summed over one tick) */
+    PHASE_WHITELIST,
+    /** @brief Stopping or continuing processes or cgroups */
+    PHASE_SIGNALS,
+    /** @brief Writing log lines (summed over one tick) */
+    PHASE_LOGGING,
+    /** @brief Recording telemetry */
+    PHASE_TELEMETRY,
+    /** @brief Number of phases */
+    PHASE_COUNT
+  };
+
+  /** @brief Monotonic event count */
+  enum Counter : size_t {
+    /** @brief Ticks */
+    COUNTER_TICKS,
+    /** @brief Processes or cgroups measured */
+    COUNTER_SCANNED,
+    /** @brief Whitelist evaluations */
+    COUNTER_WHITELIST_CHECKS,
+    /** @brief Signals sent or cgroup limits written */
+    COUNTER_SIGNALS,
+    /** @brief Throttle settings written */
+    COUNTER_WRITES,
+    /** @brief Throttle settings left unchanged by a pass */
+    COUNTER_WRITES_SKIPPED,
+    /** @brief Log lines written */
+    COUNTER_LOG_LINES,
+    /** @brief Number of counters */
+    COUNTER_COUNT
+  };
+
+  /** @brief Records the lifetime of a scope into a phase, if stats exist */
+  class Timer {
+   private:
+    /** @brief Recorder (null to do nothing) */
+    Stats *stats_;
+
+    /** @brief Timed phase */
+    Phase phase_;
+
+    /** @brief Start of the scope */
+    std::chrono::steady_clock::time_point begin_;
+
+   public:
+    /**
+     * @brief Construct a new Timer object, starting the clock
+     *
+     * @param stats Recorder (null to do nothing)
+     * @param phase Timed phase
+     */
+    Timer(Stats *stats, Phase phase);
+
+    /** @brief Destroy the Timer object, recording the elapsed time */
+    ~Timer();
+
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+  };
+
+ private:
+  /**
+   * @brief Number of finite histogram buckets; bucket i holds durations up
+   * to 2^i microseconds
+   */
+  static constexpr size_t BUCKET_COUNT_ = 21;
+
+  /** @brief Phase timing histogram */
+  struct Histogram {
+    /** @brief Observations per bucket; the last one is +Inf */
+    std::array<std::atomic<u_long>, BUCKET_COUNT_ + 1> buckets{};
+    /** @brief Number of observations */
+    std::atomic<u_long> count{0};
+    /** @brief Sum of observations (in nanoseconds) */
+    std::atomic<u_long> sum_ns{0};
+  };
+
+  /** @brief Location of the textfile */
+  std::string path_;
+
+  /** @brief Time between publications */
+  std::chrono::milliseconds interval_;
+
+  /** @brief Time of the last publication */
+  std::chrono::steady_clock::time_point last_publish_;
+
+  /** @brief Histogram of every phase */
+  std::array<Histogram, PHASE_COUNT> phases_;
+
+  /** @brief Value of every counter */
+  std::array<std::atomic<u_long>, COUNTER_COUNT> counters_{};
+
+  /** @brief Running totals last passed to observe_total, per phase */
+  std::array<std::chrono::nanoseconds, PHASE_COUNT> last_totals_{};
+
+  /**
+   * @brief Formats every metric in the Prometheus text format
+   *
+   * @return std::string
+   */
+  std::string format_() const;
+
+ public:
+  /**
+   * @brief Construct a new Stats object and publish it once
+   *
+   * @param path Location of the textfile
+   * @param interval_ms Time between publications (in milliseconds)
+   * @throw templimiter::error::IOError if the textfile cannot be written
+   */
+  Stats(const std::string &path, uint interval_ms);
+
+  Stats(const Stats &) = delete;
+  Stats &operator=(const Stats &) = delete;
+
+  /**
+   * @brief Adds one observation to a phase
+   *
+   * @param phase Timed phase
+   * @param elapsed Duration of the phase
+   */
+  void observe(Phase phase, std::chrono::nanoseconds elapsed);
+
+  /**
+   * @brief Adds to a counter
+   *
+   * @param counter Counter to add to
+   * @param n Amount
+   */
+  void add(Counter counter, u_long n = 1);
+
+  /**
+   * @brief Sets a counter kept elsewhere as a running total
+   *
+   * @param counter Counter to set
+   * @param total Running total
+   */
+  void set(Counter counter, u_long total);
+
+  /**
+   * @brief Observes the growth of a running time total since the last call,
+   * if any, and sets its event counter
+   *
+   * @param phase Timed phase
+   * @param counter Counter of the timed events
+   * @param count_total Running total of events
+   * @param time_total Running total of time spent
+   */
+  void observe_total(Phase phase, Counter counter, u_long count_total,
+                     std::chrono::nanoseconds time_total);
+
+  /**
+   * @brief Returns the location of the textfile
+   * @return const std::string&
+   */
+  const std::string &path() const;
+
+  /**
+   * @brief Publishes the textfile if stats_interval has passed
+   *
+   * @return true if the textfile was published or is not yet due
+   * @return false if it could not be written (retried at the next interval)
+   */
+  bool publish_if_due();
+
+  /**
+   * @brief Replaces the textfile atomically with the current values
+   *
+   * @return true if the textfile was replaced
+   * @return false if it could not be written
+   */
+  bool publish();
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
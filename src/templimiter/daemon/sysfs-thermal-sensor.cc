@@ -0,0 +1,55 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file sysfs-thermal-sensor.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::SysfsThermalSensor class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/sysfs-thermal-sensor.h"
+
+#include <memory>
+#include <vector>
+
+#include "templimiter/io/file-collection.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+SysfsThermalSensor::SysfsThermalSensor(
+    const std::shared_ptr<io::FileCollection<u_long>> &files)
+    : files_(files) {}
+
+u_long SysfsThermalSensor::read() { return files_->max_line(); }
+
+const std::vector<u_long> &SysfsThermalSensor::temps() const {
+  return files_->contents();
+}
+
+size_t SysfsThermalSensor::size() const { return files_->size(); }
+
+std::vector<int> SysfsThermalSensor::descriptors() const {
+  return files_->descriptors();
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
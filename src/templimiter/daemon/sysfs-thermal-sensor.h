@@ -0,0 +1,62 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file sysfs-thermal-sensor.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::SysfsThermalSensor class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <memory>
+#include <vector>
+
+#include "templimiter/daemon/thermal-sensor.h"
+#include "templimiter/io/file-collection.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/** @brief Reads thermal zone temperatures from sysfs temp attributes */
+class SysfsThermalSensor : public ThermalSensor {
+ private:
+  /** @brief Temperature files, one per zone */
+  std::shared_ptr<io::FileCollection<u_long>> files_;
+
+ public:
+  /**
+   * @brief Construct a new SysfsThermalSensor object
+   *
+   * @param files Temperature files, one per zone
+   */
+  explicit SysfsThermalSensor(
+      const std::shared_ptr<io::FileCollection<u_long>> &files);
+
+  u_long read() override;
+  const std::vector<u_long> &temps() const override;
+  size_t size() const override;
+  std::vector<int> descriptors() const override;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
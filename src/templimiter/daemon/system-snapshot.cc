@@ -0,0 +1,74 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file system-snapshot.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::SystemSnapshot class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/system-snapshot.h"
+
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "templimiter/error/internal-error.h"
+#include "templimiter/io/file.h"
+#include "templimiter/tools/string.h"
+#include "templimiter/tools/type-convert.h"
+#include "templimiter/tools/vector.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+u_long SystemSnapshot::sum_cpu_line_(const std::string &line) {
+  std::vector<std::string> spl = tools::split(line, ' ');
+  std::vector<u_long> cpu_times =
+      tools::convert<u_long>(tools::subvect(spl, 1, 4));
+  return std::accumulate(cpu_times.begin(), cpu_times.end(), u_long(0));
+}
+
+void SystemSnapshot::update(io::File<std::string> &proc_stat) {
+  const std::vector<std::string> &lines = proc_stat.read();
+  timestamp_ = std::chrono::steady_clock::now();
+  if (lines.size() == 0 || lines[0].compare(0, 4, "cpu ") != 0) {
+    throw error::InternalError("Could not find cpu times in /proc/stat.");
+  }
+  total_jiffies_ = sum_cpu_line_(lines[0]);
+  cpu_jiffies_.clear();
+  // Per-cpu lines directly follow the summary line
+  for (size_t i = 1; i < lines.size() && lines[i].compare(0, 3, "cpu") == 0;
+       i++) {
+    cpu_jiffies_.push_back(sum_cpu_line_(lines[i]));
+  }
+}
+
+u_long SystemSnapshot::total_jiffies() const { return total_jiffies_; }
+const std::vector<u_long> &SystemSnapshot::cpu_jiffies() const {
+  return cpu_jiffies_;
+}
+std::chrono::steady_clock::time_point SystemSnapshot::timestamp() const {
+  return timestamp_;
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,90 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file system-snapshot.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::SystemSnapshot class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "templimiter/io/file.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Holds the cpu time information read from /proc/stat once per
+ * iteration so that every process is measured against the same sample
+ */
+class SystemSnapshot {
+ private:
+  /** @brief Summed cpu time of all cpus */
+  u_long total_jiffies_ = 0;
+
+  /** @brief Summed cpu time of each cpu */
+  std::vector<u_long> cpu_jiffies_;
+
+  /** @brief Time at which the snapshot was taken */
+  std::chrono::steady_clock::time_point timestamp_;
+
+  /**
+   * @brief Sums the user, nice, system, and idle fields of a cpu line
+   *
+   * @param line Line of /proc/stat starting with "cpu"
+   * @return u_long
+   */
+  static u_long sum_cpu_line_(const std::string &line);
+
+ public:
+  /**
+   * @brief Rereads the snapshot from /proc/stat
+   *
+   * @param proc_stat File object of /proc/stat
+   * @throw templimiter::error::InternalError if no cpu line is found
+   */
+  void update(io::File<std::string> &proc_stat);
+
+  /**
+   * @brief Returns the summed cpu time of all cpus
+   * @return u_long
+   */
+  u_long total_jiffies() const;
+
+  /**
+   * @brief Returns the summed cpu time of each cpu
+   * @return const std::vector<u_long>&
+   */
+  const std::vector<u_long> &cpu_jiffies() const;
+
+  /**
+   * @brief Returns the time at which the snapshot was taken
+   * @return std::chrono::steady_clock::time_point
+   */
+  std::chrono::steady_clock::time_point timestamp() const;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
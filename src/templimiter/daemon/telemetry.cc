@@ -0,0 +1,282 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file telemetry.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Telemetry class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/telemetry.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "templimiter/error/argument-error.h"
+#include "templimiter/error/io-error.h"
+#include "templimiter/io/operations.h"
+#include "templimiter/tools/type-convert.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+constexpr char Telemetry::MAGIC_[8];
+
+namespace {
+
+/**
+ * @brief Clamps a value into a uint32_t
+ *
+ * @param value Value to clamp
+ * @return uint32_t
+ */
+uint32_t clamp_u32(u_long value) {
+  return value > std::numeric_limits<uint32_t>::max()
+             ? std::numeric_limits<uint32_t>::max()
+             : uint32_t(value);
+}
+
+/**
+ * @brief Writes a list of uint32_t values
+ *
+ * @param values First value
+ * @param count Number of values
+ * @param delimiter Text placed between values
+ * @param out Stream to write to
+ */
+void write_values(const uint32_t *values, uint32_t count,
+                  const char *delimiter, std::ostream &out) {
+  for (uint32_t i = 0; i < count; ++i) {
+    if (i > 0) out << delimiter;
+    out << values[i];
+  }
+}
+
+}  // namespace
+
+uint32_t Telemetry::record_size_(uint32_t zone_count, uint32_t cpu_count) {
+  size_t size =
+      sizeof(Record) + (size_t(zone_count) + cpu_count) * sizeof(uint32_t);
+  // Keep every record 8-byte aligned
+  return uint32_t((size + 7) & ~size_t(7));
+}
+
+Telemetry::Header *Telemetry::header_() const {
+  return reinterpret_cast<Header *>(map_);
+}
+
+char *Telemetry::record_at_(uint64_t slot) const {
+  return map_ + sizeof(Header) + slot * header_()->record_size;
+}
+
+void Telemetry::write_actions_(uint8_t actions, const char *delimiter,
+                               const char *quote, std::ostream &out) {
+  static constexpr struct {
+    uint8_t flag;
+    const char *name;
+  } NAMES[] = {{ACTION_THROTTLE, "throttle"},
+               {ACTION_DETHROTTLE, "dethrottle"},
+               {ACTION_STOP, "SIGSTOP"},
+               {ACTION_CONT, "SIGCONT"}};
+  bool first = true;
+  for (const auto &name : NAMES) {
+    if (!(actions & name.flag)) continue;
+    if (!first) out << delimiter;
+    out << quote << name.name << quote;
+    first = false;
+  }
+}
+
+Telemetry::Telemetry(const std::string &path, u_long size, size_t zone_count,
+                     size_t cpu_count)
+    : path_(path) {
+  uint32_t record_size =
+      record_size_(uint32_t(zone_count), uint32_t(cpu_count));
+  if (size < sizeof(Header) + record_size) {
+    throw error::ArgumentError(
+        "telemetry_size", "u_long",
+        tools::to_string(sizeof(Header) + record_size),
+        "Telemetry size is too small to hold a single record.");
+  }
+  uint64_t capacity = (size - sizeof(Header)) / record_size;
+  map_size_ = sizeof(Header) + capacity * record_size;
+
+  io::ensure_deep_parent(path_);
+  int fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd == -1) throw error::IOError(path_, "open");
+  struct stat st;
+  bool existed = ::fstat(fd, &st) == 0 && size_t(st.st_size) == map_size_;
+  if (!existed && ::ftruncate(fd, off_t(map_size_)) == -1) {
+    ::close(fd);
+    throw error::IOError(path_, "truncate");
+  }
+  void *map =
+      ::mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) throw error::IOError(path_, "mmap");
+  map_ = static_cast<char *>(map);
+
+  // Continue an existing ring only if its geometry matches
+  Header *header = header_();
+  if (!existed || std::memcmp(header->magic, MAGIC_, sizeof(MAGIC_)) != 0 ||
+      header->version != VERSION_ || header->record_size != record_size ||
+      header->zone_count != zone_count || header->cpu_count != cpu_count ||
+      header->capacity != capacity) {
+    std::memset(map_, 0, map_size_);
+    std::memcpy(header->magic, MAGIC_, sizeof(MAGIC_));
+    header->version = VERSION_;
+    header->record_size = record_size;
+    header->zone_count = uint32_t(zone_count);
+    header->cpu_count = uint32_t(cpu_count);
+    header->capacity = capacity;
+    header->written = 0;
+  }
+}
+
+Telemetry::~Telemetry() {
+  if (map_ != nullptr) ::munmap(map_, map_size_);
+}
+
+void Telemetry::record(u_long max_temp, const std::vector<u_long> &zone_temps,
+                       const std::vector<u_long> &cpu_freqs,
+                       size_t stopped_pids, uint8_t actions) {
+  Header *header = header_();
+  uint64_t written = header->written;
+  char *slot = record_at_(written % header->capacity);
+
+  timespec now;
+  ::clock_gettime(CLOCK_REALTIME_COARSE, &now);
+  Record record;
+  record.sequence = written + 1;
+  record.timestamp_ms = int64_t(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+  record.max_temp = clamp_u32(max_temp);
+  record.stopped_pids =
+      uint16_t(stopped_pids > std::numeric_limits<uint16_t>::max()
+                   ? std::numeric_limits<uint16_t>::max()
+                   : stopped_pids);
+  record.actions = actions;
+  record.reserved = 0;
+  std::memcpy(slot, &record, sizeof(record));
+
+  auto *values = reinterpret_cast<uint32_t *>(slot + sizeof(Record));
+  for (uint32_t i = 0; i < header->zone_count; ++i) {
+    *values++ = i < zone_temps.size() ? clamp_u32(zone_temps[i]) : 0;
+  }
+  for (uint32_t i = 0; i < header->cpu_count; ++i) {
+    *values++ = i < cpu_freqs.size() ? clamp_u32(cpu_freqs[i]) : 0;
+  }
+
+  // Publish the record only after it has been fully written
+  __atomic_store_n(&header->written, written + 1, __ATOMIC_RELEASE);
+}
+
+void Telemetry::dump(const std::string &path, bool as_json,
+                     std::ostream &out) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) throw error::IOError(path, "open");
+  struct stat st;
+  if (::fstat(fd, &st) == -1) {
+    ::close(fd);
+    throw error::IOError(path, "stat");
+  }
+  size_t size = size_t(st.st_size);
+  if (size < sizeof(Header)) {
+    ::close(fd);
+    throw error::IOError(path, "read", "File is not a telemetry file.");
+  }
+  void *map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) throw error::IOError(path, "mmap");
+
+  Telemetry reader;
+  reader.map_ = static_cast<char *>(map);
+  reader.map_size_ = size;
+  const Header *header = reader.header_();
+  if (std::memcmp(header->magic, MAGIC_, sizeof(MAGIC_)) != 0 ||
+      header->version != VERSION_ || header->capacity == 0 ||
+      header->record_size !=
+          record_size_(header->zone_count, header->cpu_count) ||
+      sizeof(Header) + header->capacity * header->record_size > size) {
+    throw error::IOError(path, "read", "File is not a telemetry file.");
+  }
+
+  uint64_t written = __atomic_load_n(&header->written, __ATOMIC_ACQUIRE);
+  uint64_t first = written > header->capacity ? written - header->capacity : 0;
+
+  if (as_json) {
+    out << "[";
+  } else {
+    out << "sequence,timestamp_ms,max_temp,stopped_pids,actions";
+    for (uint32_t i = 0; i < header->zone_count; ++i) out << ",zone" << i;
+    for (uint32_t i = 0; i < header->cpu_count; ++i) out << ",cpu" << i;
+    out << "\n";
+  }
+
+  bool first_record = true;
+  for (uint64_t seq = first; seq < written; ++seq) {
+    const char *slot = reader.record_at_(seq % header->capacity);
+    Record record;
+    std::memcpy(&record, slot, sizeof(record));
+    // Skip records overwritten by the daemon during the dump
+    if (record.sequence != seq + 1) continue;
+    const auto *zones =
+        reinterpret_cast<const uint32_t *>(slot + sizeof(Record));
+    const uint32_t *cpus = zones + header->zone_count;
+
+    if (as_json) {
+      out << (first_record ? "\n" : ",\n") << "  {\"sequence\": "
+          << record.sequence << ", \"timestamp_ms\": " << record.timestamp_ms
+          << ", \"max_temp\": " << record.max_temp
+          << ", \"stopped_pids\": " << record.stopped_pids
+          << ", \"actions\": [";
+      write_actions_(record.actions, ", ", "\"", out);
+      out << "], \"zone_temps\": [";
+      write_values(zones, header->zone_count, ", ", out);
+      out << "], \"cpu_freqs\": [";
+      write_values(cpus, header->cpu_count, ", ", out);
+      out << "]}";
+    } else {
+      out << record.sequence << ',' << record.timestamp_ms << ','
+          << record.max_temp << ',' << record.stopped_pids << ',';
+      write_actions_(record.actions, "|", "", out);
+      if (header->zone_count > 0) out << ',';
+      write_values(zones, header->zone_count, ",", out);
+      if (header->cpu_count > 0) out << ',';
+      write_values(cpus, header->cpu_count, ",", out);
+      out << "\n";
+    }
+    first_record = false;
+  }
+
+  if (as_json) out << (first_record ? "]\n" : "\n]\n");
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,188 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file telemetry.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Telemetry class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Records one fixed-size binary record per iteration into a
+ * memory-mapped circular file, and decodes such files
+ *
+ * The file starts with a Header followed by a ring of records; each record is
+ * a Record followed by one uint32_t temperature per thermal zone and one
+ * uint32_t target frequency per cpu. The ring survives restarts as long as
+ * the geometry (zone count, cpu count, and size) stays the same.
+ */
+class Telemetry {
+ public:
+  /** @brief Action flag: the cpu was throttled */
+  static constexpr uint8_t ACTION_THROTTLE = 1;
+  /** @brief Action flag: the cpu was dethrottled */
+  static constexpr uint8_t ACTION_DETHROTTLE = 2;
+  /** @brief Action flag: SIGSTOP was sent */
+  static constexpr uint8_t ACTION_STOP = 4;
+  /** @brief Action flag: SIGCONT was sent */
+  static constexpr uint8_t ACTION_CONT = 8;
+
+ private:
+  /** @brief Identifies a telemetry file */
+  static constexpr char MAGIC_[8] = "TLTELEM";
+
+  /** @brief Version of the file layout */
+  static constexpr uint32_t VERSION_ = 1;
+
+  /** @brief Layout of the file header */
+  struct Header {
+    /** @brief MAGIC_ */
+    char magic[8];
+    /** @brief VERSION_ */
+    uint32_t version;
+    /** @brief Size of each record including zone and cpu values */
+    uint32_t record_size;
+    /** @brief Number of thermal zone values per record */
+    uint32_t zone_count;
+    /** @brief Number of cpu frequency values per record */
+    uint32_t cpu_count;
+    /** @brief Number of records in the ring */
+    uint64_t capacity;
+    /** @brief Total number of records written (stored after each record) */
+    uint64_t written;
+  };
+
+  /** @brief Layout of the fixed part of each record */
+  struct Record {
+    /** @brief One-based record number; detects records being overwritten */
+    uint64_t sequence;
+    /** @brief Wall clock time (in milliseconds since the epoch) */
+    int64_t timestamp_ms;
+    /** @brief Maximum temperature */
+    uint32_t max_temp;
+    /** @brief Number of processes stopped by templimiter */
+    uint16_t stopped_pids;
+    /** @brief ACTION_* flags of actions taken during the iteration */
+    uint8_t actions;
+    /** @brief Unused */
+    uint8_t reserved;
+  };
+
+  /** @brief Path of the file */
+  std::string path_;
+
+  /** @brief Mapped file */
+  char *map_ = nullptr;
+
+  /** @brief Size of the mapping */
+  size_t map_size_ = 0;
+
+  /** @brief Constructs an unmapped Telemetry object (used by dump) */
+  Telemetry() = default;
+
+  /**
+   * @brief Computes the size of one record
+   *
+   * @param zone_count Number of thermal zone values
+   * @param cpu_count Number of cpu frequency values
+   * @return uint32_t
+   */
+  static uint32_t record_size_(uint32_t zone_count, uint32_t cpu_count);
+
+  /** @brief Returns the mapped header */
+  Header *header_() const;
+
+  /**
+   * @brief Returns a mapped record
+   *
+   * @param slot Index of the record in the ring
+   * @return char* Start of the record
+   */
+  char *record_at_(uint64_t slot) const;
+
+  /**
+   * @brief Writes the names of set action flags
+   *
+   * @param actions ACTION_* flags
+   * @param delimiter Text placed between names
+   * @param quote Text placed around each name
+   * @param out Stream to write to
+   */
+  static void write_actions_(uint8_t actions, const char *delimiter,
+                             const char *quote, std::ostream &out);
+
+ public:
+  /**
+   * @brief Opens (or creates) and maps a telemetry file
+   *
+   * @param path Location of the telemetry file
+   * @param size Size of the file (in bytes)
+   * @param zone_count Number of thermal zones recorded per iteration
+   * @param cpu_count Number of cpu frequencies recorded per iteration
+   * @throw templimiter::error::ArgumentError if size cannot hold one record
+   * @throw templimiter::error::IOError if the file cannot be opened or mapped
+   */
+  Telemetry(const std::string &path, u_long size, size_t zone_count,
+            size_t cpu_count);
+
+  /** @brief Unmaps the telemetry file */
+  ~Telemetry();
+
+  Telemetry(const Telemetry &) = delete;
+  Telemetry &operator=(const Telemetry &) = delete;
+
+  /**
+   * @brief Appends a record to the ring, overwriting the oldest if full
+   *
+   * @param max_temp Maximum temperature
+   * @param zone_temps Temperature of each thermal zone
+   * @param cpu_freqs Target frequency of each cpu
+   * @param stopped_pids Number of processes stopped by templimiter
+   * @param actions ACTION_* flags of actions taken during the iteration
+   */
+  void record(u_long max_temp, const std::vector<u_long> &zone_temps,
+              const std::vector<u_long> &cpu_freqs, size_t stopped_pids,
+              uint8_t actions);
+
+  /**
+   * @brief Decodes a telemetry file, oldest record first
+   *
+   * @param path Location of the telemetry file
+   * @param as_json Whether to write a JSON array instead of CSV
+   * @param out Stream to write to
+   * @throw templimiter::error::IOError if the file cannot be read or is not
+   * a telemetry file
+   */
+  static void dump(const std::string &path, bool as_json, std::ostream &out);
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
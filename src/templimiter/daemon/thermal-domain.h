@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file thermal-domain.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ThermalDomain struct
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief A group of cpufreq policies that is throttled by the temperature of
+ * its own thermal zones (e.g. one cpu package)
+ */
+struct ThermalDomain {
+  /** @brief Package id of the domain, or -1 if it covers every package */
+  int package;
+  /** @brief Indices of the thermal files that heat this domain */
+  std::vector<size_t> zones;
+  /** @brief Indices of the cpufreq policies throttled with this domain */
+  std::vector<size_t> policies;
+
+  /**
+   * @brief Returns the highest temperature of the domain's zones
+   *
+   * @param temps Last read value of every thermal file
+   * @return u_long
+   */
+  u_long max_temp(const std::vector<u_long> &temps) const {
+    u_long max = 0;
+    for (size_t i : zones) {
+      if (i < temps.size() && temps[i] > max) max = temps[i];
+    }
+    return max;
+  }
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
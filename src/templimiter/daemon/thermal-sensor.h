@@ -0,0 +1,76 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file thermal-sensor.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ThermalSensor class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Interface of a temperature source read once per Monitor tick
+ *
+ * Zone indices match the ones used by every ThermalDomain
+ */
+class ThermalSensor {
+ public:
+  virtual ~ThermalSensor() = default;
+
+  /**
+   * @brief Reads every zone and returns the highest temperature
+   *
+   * @return u_long Maximum temperature (in millidegrees Celsius)
+   */
+  virtual u_long read() = 0;
+
+  /**
+   * @brief Returns the temperature of every zone from the last read()
+   *
+   * @return const std::vector< u_long >&
+   */
+  virtual const std::vector<u_long> &temps() const = 0;
+
+  /**
+   * @brief Returns the number of zones
+   *
+   * @return size_t
+   */
+  virtual size_t size() const = 0;
+
+  /**
+   * @brief Returns descriptors that may be polled for POLLPRI while idle
+   * (negative descriptors are ignored)
+   *
+   * @return std::vector< int >
+   */
+  virtual std::vector<int> descriptors() const = 0;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,141 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file throttle-actuator.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ThrottleActuator class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+#include "templimiter/daemon/thermal-domain.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Interface of a throttle backend: the lever that throttle mode pulls
+ * to limit each thermal domain (cpu frequency ceilings, power caps)
+ *
+ * Every pass starts with begin() and ends with flush(); settings that are
+ * changed outside templimiter are reported through found_unexpected()
+ */
+class ThrottleActuator {
+ public:
+  /** @brief set_level result flag: a setting was lowered */
+  static constexpr int LOWERED = 1;
+
+  /** @brief set_level result flag: a setting was raised */
+  static constexpr int RAISED = 2;
+
+  virtual ~ThrottleActuator() = default;
+
+  /**
+   * @brief Returns the name of the limited setting, used in warnings
+   * @return std::string
+   */
+  virtual std::string setting_name() const = 0;
+
+  /** @brief Starts a pass; current settings are reread when needed */
+  virtual void begin() = 0;
+
+  /**
+   * @brief Checks whether or not a domain is currently limited
+   *
+   * @param domain Thermal domain to check
+   * @return true if any setting of the domain is below its maximum
+   * @return false if the domain is unlimited
+   */
+  virtual bool is_below_max(const ThermalDomain &domain) = 0;
+
+  /**
+   * @brief Checks whether or not a domain can be limited further
+   *
+   * @param domain Thermal domain to check
+   * @return true if any setting of the domain is above its minimum
+   * @return false if the domain is fully limited
+   */
+  virtual bool is_above_min(const ThermalDomain &domain) = 0;
+
+  /**
+   * @brief Limits a domain one step further
+   *
+   * @param domain Thermal domain to throttle
+   */
+  virtual void throttle(const ThermalDomain &domain) = 0;
+
+  /**
+   * @brief Releases a domain by one step
+   *
+   * @param domain Thermal domain to dethrottle
+   */
+  virtual void dethrottle(const ThermalDomain &domain) = 0;
+
+  /**
+   * @brief Sets a domain to a throttle amount between its extremes
+   *
+   * @param domain Thermal domain to set
+   * @param throttle Throttle amount, from 0 (unlimited) to 1 (fully limited)
+   * @return int LOWERED and/or RAISED if any setting changed
+   */
+  virtual int set_level(const ThermalDomain &domain, double throttle) = 0;
+
+  /**
+   * @brief Writes every setting changed during the pass
+   *
+   * @return size_t Number of settings written
+   */
+  virtual size_t flush() = 0;
+
+  /**
+   * @brief Checks whether or not any expected setting is below its maximum
+   *
+   * @return true if any domain is limited
+   * @return false if every domain is unlimited
+   */
+  virtual bool is_limited() const = 0;
+
+  /**
+   * @brief Returns whether or not a setting was found changed elsewhere
+   *
+   * @return true if the actuator is waiting for resync()
+   * @return false if every setting was as expected
+   */
+  virtual bool found_unexpected() const = 0;
+
+  /** @brief Adopts the current settings as the expected ones */
+  virtual void resync() = 0;
+
+  /**
+   * @brief Returns the expected value of every setting (for telemetry)
+   *
+   * @return const std::vector< u_long >&
+   */
+  virtual const std::vector<u_long> &settings() const = 0;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
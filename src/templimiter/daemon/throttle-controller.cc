@@ -0,0 +1,81 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file throttle-controller.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ThrottleController class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/throttle-controller.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace templimiter {
+
+namespace daemon {
+
+ThrottleController::ThrottleController(u_long target, double kp, double ki,
+                                       double kd)
+    : target_(target), kp_(kp), ki_(ki), kd_(kd) {}
+
+void ThrottleController::retune(u_long target, double kp, double ki,
+                                double kd) {
+  // Rescaled so that the integral term carries over unchanged
+  if (ki > 0) integral_ = std::clamp(integral_ * ki_ / ki, 0.0, 1 / ki);
+  target_ = target;
+  kp_ = kp;
+  ki_ = ki;
+  kd_ = kd;
+}
+
+double ThrottleController::update(u_long temp) {
+  auto now = std::chrono::steady_clock::now();
+  double error = (double(temp) - double(target_)) / 1000;
+  double elapsed = 0;
+  if (has_sample_) {
+    elapsed = std::chrono::duration<double>(now - last_time_).count();
+    if (elapsed > 0) {
+      double cur_slope = (double(temp) - double(last_temp_)) / 1000 / elapsed;
+      slope_ = SLOPE_WEIGHT_ * cur_slope + (1 - SLOPE_WEIGHT_) * slope_;
+    }
+  }
+  has_sample_ = true;
+  last_temp_ = temp;
+  last_time_ = now;
+
+  // Conditional integration: hold the integral while saturated against it
+  bool saturated =
+      (throttle_ >= 1 && error > 0) || (throttle_ <= 0 && error < 0);
+  if (!saturated && ki_ > 0) {
+    integral_ = std::clamp(integral_ + error * elapsed, 0.0, 1 / ki_);
+  }
+
+  // The derivative acts on the measurement, so it has no setpoint kick
+  double output = kp_ * error + ki_ * integral_ + kd_ * slope_;
+  throttle_ = std::clamp(output, 0.0, 1.0);
+  return throttle_;
+}
+
+double ThrottleController::throttle() const { return throttle_; }
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,117 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file throttle-controller.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::ThrottleController class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <chrono>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief PID controller that turns the distance from a target temperature
+ * into a throttle amount, from 0 (highest frequency) to 1 (lowest frequency)
+ */
+class ThrottleController {
+ private:
+  /** @brief Weight of the newest sample in the smoothed slope */
+  static constexpr double SLOPE_WEIGHT_ = 0.5;
+
+  /** @brief Temperature to hold (in millidegrees) */
+  u_long target_;
+
+  /** @brief Proportional gain (throttle per degree above target) */
+  double kp_;
+
+  /** @brief Integral gain (throttle per degree second above target) */
+  double ki_;
+
+  /** @brief Derivative gain (throttle per degree per second of rise) */
+  double kd_;
+
+  /** @brief Accumulated error (in degree seconds) */
+  double integral_ = 0;
+
+  /** @brief Smoothed temperature slope (in degrees per second) */
+  double slope_ = 0;
+
+  /** @brief Output of the last update */
+  double throttle_ = 0;
+
+  /** @brief Whether or not a previous sample exists */
+  bool has_sample_ = false;
+
+  /** @brief Temperature of the previous sample */
+  u_long last_temp_ = 0;
+
+  /** @brief Time of the previous sample */
+  std::chrono::steady_clock::time_point last_time_;
+
+ public:
+  /**
+   * @brief Construct a new ThrottleController object
+   *
+   * @param target Temperature to hold (in millidegrees)
+   * @param kp Proportional gain (throttle per degree above target)
+   * @param ki Integral gain (throttle per degree second above target)
+   * @param kd Derivative gain (throttle per degree per second of rise)
+   */
+  ThrottleController(u_long target, double kp, double ki, double kd);
+
+  /**
+   * @brief Changes the target and gains, carrying the integral term over
+   * so that the throttle amount does not restart from zero
+   *
+   * @param target Temperature to hold (in millidegrees)
+   * @param kp Proportional gain
+   * @param ki Integral gain
+   * @param kd Derivative gain
+   */
+  void retune(u_long target, double kp, double ki, double kd);
+
+  /**
+   * @brief Records a temperature sample and returns the new throttle amount
+   *
+   * The integral only grows while the output is not saturated in the
+   * direction of the error, and is limited to a full throttle on its own, so
+   * long stretches at either end of the ladder do not wind it up
+   *
+   * @param temp Current temperature (in millidegrees)
+   * @return double Throttle amount, from 0 to 1
+   */
+  double update(u_long temp);
+
+  /**
+   * @brief Returns the output of the last update
+   * @return double Throttle amount, from 0 to 1
+   */
+  double throttle() const;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
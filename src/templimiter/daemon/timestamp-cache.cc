@@ -0,0 +1,84 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file timestamp-cache.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::TimestampCache class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/timestamp-cache.h"
+
+#include <time.h>
+#include <ctime>
+#include <string>
+
+namespace templimiter {
+
+namespace daemon {
+
+void TimestampCache::format_minute_(time_t now) {
+  struct tm local;
+  localtime_r(&now, &local);
+  char prefix[32];
+  char zone[16];
+  size_t prefix_len = strftime(prefix, sizeof(prefix), "%FT%H:%M:", &local);
+  size_t zone_len = strftime(zone, sizeof(zone), "%z", &local);
+
+  text_.assign(prefix, prefix_len);
+  second_pos_ = prefix_len;
+  text_ += use_milliseconds_ ? "00.000" : "00";
+  text_.append(zone, zone_len);
+
+  has_minute_ = true;
+  minute_start_ = now - local.tm_sec;
+  // Force the seconds digits to be written
+  second_ = minute_start_ - 1;
+}
+
+void TimestampCache::write_digits_(size_t pos, size_t width, long value) {
+  for (size_t i = width; i > 0; i--) {
+    text_[pos + i - 1] = char('0' + value % 10);
+    value /= 10;
+  }
+}
+
+TimestampCache::TimestampCache(bool use_milliseconds)
+    : use_milliseconds_(use_milliseconds) {}
+
+const std::string &TimestampCache::get() {
+  // The coarse clock is read without a syscall through the vDSO
+  timespec now;
+  clock_gettime(CLOCK_REALTIME_COARSE, &now);
+  if (!has_minute_ || now.tv_sec < minute_start_ ||
+      now.tv_sec >= minute_start_ + 60) {
+    format_minute_(now.tv_sec);
+  }
+  if (now.tv_sec != second_) {
+    write_digits_(second_pos_, 2, long(now.tv_sec - minute_start_));
+    second_ = now.tv_sec;
+  }
+  if (use_milliseconds_) {
+    write_digits_(second_pos_ + 3, 3, now.tv_nsec / 1000000);
+  }
+  return text_;
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,94 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file timestamp-cache.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::TimestampCache class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <ctime>
+#include <string>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Formats "%FT%T%z" timestamps, only rewriting the seconds (and
+ * milliseconds) digits in place until the minute changes
+ */
+class TimestampCache {
+ private:
+  /** @brief Whether or not milliseconds are appended to the seconds */
+  bool use_milliseconds_;
+
+  /** @brief Current timestamp text */
+  std::string text_;
+
+  /** @brief Whether or not text_ holds a formatted minute */
+  bool has_minute_ = false;
+
+  /** @brief Time at the start of the formatted minute */
+  time_t minute_start_ = 0;
+
+  /** @brief Second currently written to text_ */
+  time_t second_ = 0;
+
+  /** @brief Position of the seconds digits in text_ */
+  size_t second_pos_ = 0;
+
+  /**
+   * @brief Reformats the date, hour, minute, and timezone (takes the
+   * timezone lock through localtime_r)
+   *
+   * @param now Current time
+   */
+  void format_minute_(time_t now);
+
+  /**
+   * @brief Writes a zero-padded number into text_
+   *
+   * @param pos Position of the first digit
+   * @param width Number of digits
+   * @param value Value to write
+   */
+  void write_digits_(size_t pos, size_t width, long value);
+
+ public:
+  /**
+   * @brief Construct a new TimestampCache object
+   *
+   * @param use_milliseconds Whether or not milliseconds are appended to the
+   * seconds
+   */
+  explicit TimestampCache(bool use_milliseconds = false);
+
+  /**
+   * @brief Returns the current timestamp (valid until the next call)
+   *
+   * @return const std::string&
+   */
+  const std::string &get();
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
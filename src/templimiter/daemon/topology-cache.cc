@@ -0,0 +1,143 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file topology-cache.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::TopologyCache class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/topology-cache.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "templimiter/error/error.h"
+#include "templimiter/io/operations.h"
+#include "templimiter/tools/string.h"
+#include "templimiter/tools/type-convert.h"
+#include "templimiter/tools/vector.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+namespace {
+
+/** @brief First line of a cache file; changes with the format */
+const std::string CACHE_HEADER = "templimiter-topology 1";
+
+/**
+ * @brief Reads a section written as a "<name> <count>" line followed by
+ * count lines
+ *
+ * @param in Cache file
+ * @param name Expected section name
+ * @param lines Lines of the section
+ * @return true if the section was found whole
+ * @return false if the file is malformed
+ */
+bool read_section(std::istream &in, const std::string &name,
+                  std::vector<std::string> &lines) {
+  std::string line;
+  if (!std::getline(in, line)) return false;
+  std::vector<std::string> spl = tools::split(line, ' ');
+  if (spl.size() != 2 || spl[0] != name) return false;
+  size_t count = tools::convert<size_t>(spl[1]);
+  lines.clear();
+  while (lines.size() < count && std::getline(in, line)) {
+    lines.push_back(line);
+  }
+  return lines.size() == count;
+}
+
+/**
+ * @brief Writes a section readable by read_section
+ *
+ * @param out Cache text
+ * @param name Section name
+ * @param lines Lines of the section
+ */
+void write_section(std::ostream &out, const std::string &name,
+                   const std::vector<std::string> &lines) {
+  out << name << ' ' << lines.size() << '\n';
+  for (const auto &line : lines) out << line << '\n';
+}
+
+}  // namespace
+
+TopologyCache::TopologyCache(const std::string &path, const std::string &key)
+    : path_(path), key_(key) {}
+
+bool TopologyCache::load(CpufreqTopology &topology) const {
+  std::ifstream in(path_);
+  std::string header;
+  std::string key;
+  if (!std::getline(in, header) || header != CACHE_HEADER ||
+      !std::getline(in, key) || key != key_) {
+    return false;
+  }
+  std::vector<std::string> related;
+  std::vector<std::string> available;
+  std::vector<std::string> max_freqs;
+  std::vector<std::string> min_freqs;
+  try {
+    if (!read_section(in, "related_cpus", related) ||
+        !read_section(in, "available_frequencies", available) ||
+        !read_section(in, "cpuinfo_max_freq", max_freqs) ||
+        !read_section(in, "cpuinfo_min_freq", min_freqs)) {
+      return false;
+    }
+    CpufreqTopology loaded;
+    loaded.related_cpus = related;
+    for (const auto &line : available) {
+      loaded.available_frequencies.push_back(
+          tools::convert<u_long>(tools::split(line, ' ')));
+    }
+    loaded.cpuinfo_max_freqs = tools::convert<u_long>(max_freqs);
+    loaded.cpuinfo_min_freqs = tools::convert<u_long>(min_freqs);
+    topology = loaded;
+  } catch (const error::Error &) {
+    return false;
+  }
+  return true;
+}
+
+bool TopologyCache::store(const CpufreqTopology &topology) const {
+  std::ostringstream out;
+  out << CACHE_HEADER << '\n' << key_ << '\n';
+  write_section(out, "related_cpus", topology.related_cpus);
+  std::vector<std::string> available;
+  for (const auto &freqs : topology.available_frequencies) {
+    available.push_back(tools::join(tools::convert<std::string>(freqs), " "));
+  }
+  write_section(out, "available_frequencies", available);
+  write_section(out, "cpuinfo_max_freq",
+                tools::convert<std::string>(topology.cpuinfo_max_freqs));
+  write_section(out, "cpuinfo_min_freq",
+                tools::convert<std::string>(topology.cpuinfo_min_freqs));
+
+  // A daemon starting alongside must never read a partial file
+  return io::replace_file(path_, out.str());
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
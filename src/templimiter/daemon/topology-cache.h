@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file topology-cache.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::TopologyCache class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+namespace templimiter {
+
+namespace daemon {
+
+/** @brief cpufreq values that stay fixed until the next boot */
+struct CpufreqTopology {
+  /** @brief related_cpus of each scaling_max_freq file (empty if absent) */
+  std::vector<std::string> related_cpus;
+  /** @brief Frequencies of each matched scaling_available_frequencies file */
+  std::vector<std::vector<u_long>> available_frequencies;
+  /** @brief Value of each matched cpuinfo_max_freq file */
+  std::vector<u_long> cpuinfo_max_freqs;
+  /** @brief Value of each matched cpuinfo_min_freq file */
+  std::vector<u_long> cpuinfo_min_freqs;
+};
+
+/**
+ * @brief Keeps a CpufreqTopology in a small file so that a restarted daemon
+ * can skip reading every cpufreq file again
+ *
+ * The file is only used when it was written under the same key, which
+ * names the boot, the matchers, and the matched cpus.
+ */
+class TopologyCache {
+ private:
+  /** @brief Location of the cache file */
+  std::string path_;
+
+  /** @brief Key that the cache file must have been written under */
+  std::string key_;
+
+ public:
+  /**
+   * @brief Construct a new TopologyCache object
+   *
+   * @param path Location of the cache file
+   * @param key Boot id and discovery inputs (must not contain newlines)
+   */
+  TopologyCache(const std::string &path, const std::string &key);
+
+  /**
+   * @brief Reads the cached topology
+   *
+   * @param topology Cached topology
+   * @return true if the file exists, was written under the same key, and is
+   * well formed
+   * @return false if the topology must be discovered again
+   */
+  bool load(CpufreqTopology &topology) const;
+
+  /**
+   * @brief Replaces the cache file atomically
+   *
+   * @param topology Discovered topology
+   * @return true if written
+   * @return false if the file could not be written
+   */
+  bool store(const CpufreqTopology &topology) const;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,143 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file whitelist.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Whitelist class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/daemon/whitelist.h"
+
+#include <sys/types.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "templimiter/tools/string.h"
+
+namespace templimiter {
+
+namespace daemon {
+
+template <typename T>
+std::vector<T> Whitelist::sorted_(std::vector<T> values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+bool Whitelist::matches_pattern_(const Pattern &pattern,
+                                 const std::string &comm) {
+  size_t pos = 0;
+  for (size_t i = 0; i < pattern.parts.size(); ++i) {
+    const std::string &part = pattern.parts[i];
+    bool is_first = i == 0;
+    bool is_last = i + 1 == pattern.parts.size();
+    if (is_last && pattern.anchored_end) {
+      // last part must end the comm without overlapping earlier parts
+      if (comm.size() < pos + part.size() ||
+          comm.compare(comm.size() - part.size(), part.size(), part) != 0) {
+        return false;
+      }
+      return !(is_first && pattern.anchored_start) ||
+             comm.size() == part.size();
+    }
+    if (is_first && pattern.anchored_start) {
+      if (comm.compare(0, part.size(), part) != 0) return false;
+      pos = part.size();
+    } else {
+      pos = comm.find(part, pos);
+      if (pos == std::string::npos) return false;
+      pos += part.size();
+    }
+  }
+  return true;
+}
+
+bool Whitelist::matches_comm_(const std::string &comm) const {
+  if (comm_literals_.count(comm) > 0) return true;
+  for (const auto &pattern : comm_patterns_) {
+    if (matches_pattern_(pattern, comm)) return true;
+  }
+  return false;
+}
+
+Whitelist::Whitelist() {}
+
+Whitelist::Whitelist(const std::vector<pid_t> &pid,
+                     const std::vector<std::string> &comm,
+                     const std::vector<char> &state,
+                     const std::vector<pid_t> &ppid,
+                     const std::vector<int> &pgrp,
+                     const std::vector<int> &session,
+                     const std::vector<int> &tty_nr,
+                     const std::vector<int> &tpgid,
+                     const std::vector<uint> &flags, long max_nice)
+    : pid_(sorted_(pid)),
+      ppid_(sorted_(ppid)),
+      pgrp_(sorted_(pgrp)),
+      session_(sorted_(session)),
+      tty_nr_(sorted_(tty_nr)),
+      tpgid_(sorted_(tpgid)),
+      flags_(sorted_(flags)),
+      max_nice_(max_nice) {
+  for (char c : state) state_.set(static_cast<unsigned char>(c));
+  for (const auto &v : comm) {
+    if (v.find('*') == std::string::npos) {
+      comm_literals_.insert(v);
+    } else {
+      // split once here rather than for every process
+      comm_patterns_.push_back(
+          Pattern{tools::split(v, '*'), v.front() != '*', v.back() != '*'});
+    }
+  }
+}
+
+void Whitelist::replace_rules(const Whitelist &rules) {
+  pid_ = rules.pid_;
+  state_ = rules.state_;
+  ppid_ = rules.ppid_;
+  pgrp_ = rules.pgrp_;
+  session_ = rules.session_;
+  tty_nr_ = rules.tty_nr_;
+  tpgid_ = rules.tpgid_;
+  flags_ = rules.flags_;
+  max_nice_ = rules.max_nice_;
+  comm_literals_ = rules.comm_literals_;
+  comm_patterns_ = rules.comm_patterns_;
+}
+
+bool Whitelist::matches(pid_t pid, const std::string &comm, char state,
+                        pid_t ppid, int pgrp, int session, int tty_nr,
+                        int tpgid, uint flags, long nice) const {
+  return nice < max_nice_ ||
+         std::binary_search(pid_.begin(), pid_.end(), pid) ||
+         state_.test(static_cast<unsigned char>(state)) ||
+         std::binary_search(ppid_.begin(), ppid_.end(), ppid) ||
+         std::binary_search(pgrp_.begin(), pgrp_.end(), pgrp) ||
+         std::binary_search(session_.begin(), session_.end(), session) ||
+         std::binary_search(tty_nr_.begin(), tty_nr_.end(), tty_nr) ||
+         std::binary_search(tpgid_.begin(), tpgid_.end(), tpgid) ||
+         std::binary_search(flags_.begin(), flags_.end(), flags) ||
+         matches_comm_(comm);
+}
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,150 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file whitelist.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::daemon::Whitelist class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <bitset>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace templimiter {
+
+namespace daemon {
+
+/**
+ * @brief Holds the configured whitelist in a form that is cheap to test each
+ * process against: sorted numeric lists, a state char set, a hash set of
+ * literal comm values, and pre-split comm patterns
+ */
+class Whitelist {
+ private:
+  /** @brief Comm pattern split on its asterisks */
+  struct Pattern {
+    /** @brief Literal pieces that must appear in order */
+    std::vector<std::string> parts;
+    /** @brief Whether or not the first piece must start the comm */
+    bool anchored_start;
+    /** @brief Whether or not the last piece must end the comm */
+    bool anchored_end;
+  };
+
+  /** @brief Sorted whitelisted pids */
+  std::vector<pid_t> pid_;
+  /** @brief Whitelisted state chars */
+  std::bitset<256> state_;
+  /** @brief Sorted whitelisted ppids */
+  std::vector<pid_t> ppid_;
+  /** @brief Sorted whitelisted pgrps */
+  std::vector<int> pgrp_;
+  /** @brief Sorted whitelisted sessions */
+  std::vector<int> session_;
+  /** @brief Sorted whitelisted tty_nrs */
+  std::vector<int> tty_nr_;
+  /** @brief Sorted whitelisted tpgids */
+  std::vector<int> tpgid_;
+  /** @brief Sorted whitelisted flags */
+  std::vector<uint> flags_;
+  /** @brief Nice values lower than this are whitelisted */
+  long max_nice_ = -21;
+  /** @brief Whitelisted comm values without asterisks */
+  std::unordered_set<std::string> comm_literals_;
+  /** @brief Whitelisted comm values with asterisks */
+  std::vector<Pattern> comm_patterns_;
+
+  /**
+   * @brief Sorts a list and removes duplicates
+   *
+   * @param values List to use
+   * @return std::vector< T >
+   */
+  template <typename T>
+  static std::vector<T> sorted_(std::vector<T> values);
+
+  /**
+   * @brief Checks a comm value against a pattern
+   *
+   * @param pattern Pattern to use
+   * @param comm Comm to check
+   * @return true if comm matches pattern
+   * @return false if comm does not match pattern
+   */
+  static bool matches_pattern_(const Pattern &pattern, const std::string &comm);
+
+  /**
+   * @brief Checks a comm value against the literals and patterns
+   *
+   * @param comm Comm to check
+   * @return true if whitelisted
+   * @return false if not whitelisted
+   */
+  bool matches_comm_(const std::string &comm) const;
+
+ public:
+  /** @brief Construct an empty Whitelist object */
+  Whitelist();
+
+  /**
+   * @brief Compiles the configured whitelist values
+   *
+   * @param pid Whitelisted pids
+   * @param comm Whitelisted comm values (may use * matching)
+   * @param state Whitelisted state chars
+   * @param ppid Whitelisted ppids
+   * @param pgrp Whitelisted pgrps
+   * @param session Whitelisted sessions
+   * @param tty_nr Whitelisted tty_nrs
+   * @param tpgid Whitelisted tpgids
+   * @param flags Whitelisted flags
+   * @param max_nice Nice values lower than this are whitelisted
+   */
+  Whitelist(const std::vector<pid_t> &pid,
+            const std::vector<std::string> &comm,
+            const std::vector<char> &state, const std::vector<pid_t> &ppid,
+            const std::vector<int> &pgrp, const std::vector<int> &session,
+            const std::vector<int> &tty_nr, const std::vector<int> &tpgid,
+            const std::vector<uint> &flags, long max_nice);
+
+  /**
+   * @brief Replaces every rule with those of another Whitelist
+   *
+   * @param rules Whitelist to copy the rules from
+   */
+  void replace_rules(const Whitelist &rules);
+
+  /**
+   * @brief Checks process properties against the whitelist
+   *
+   * @return true if any property is whitelisted
+   * @return false if none are whitelisted
+   */
+  bool matches(pid_t pid, const std::string &comm, char state, pid_t ppid,
+               int pgrp, int session, int tty_nr, int tpgid, uint flags,
+               long nice) const;
+};
+
+}  // namespace daemon
+
+}  // namespace templimiter
@@ -0,0 +1,171 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file async-log-writer.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::AsyncLogWriter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/io/async-log-writer.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "templimiter/tools/type-convert.h"
+
+#include "templimiter/error/io-error.h"
+#include "templimiter/io/operations.h"
+
+namespace templimiter {
+
+namespace io {
+
+size_t AsyncLogWriter::pending_() const {
+  return tail_.load(std::memory_order_acquire) -
+         head_.load(std::memory_order_acquire);
+}
+
+void AsyncLogWriter::wake_writer_() {
+  // Taking the lock orders the request before the writer's predicate check
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  wake_.notify_one();
+}
+
+bool AsyncLogWriter::write_batch_(size_t first, size_t count) {
+  iovec iov[WRITEV_BATCH_];
+  for (size_t i = 0; i < count; i++) {
+    std::string &record = ring_[(first + i) & (CAPACITY_ - 1)];
+    iov[i].iov_base = record.data();
+    iov[i].iov_len = record.size();
+  }
+  iovec *cur = iov;
+  int remaining = int(count);
+  while (remaining > 0) {
+    ssize_t n = ::writev(fd_, cur, remaining);
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    // Skip fully written records and adjust a partially written one
+    size_t written = size_t(n);
+    while (remaining > 0 && written >= cur->iov_len) {
+      written -= cur->iov_len;
+      cur++;
+      remaining--;
+    }
+    if (remaining > 0) {
+      cur->iov_base = static_cast<char *>(cur->iov_base) + written;
+      cur->iov_len -= written;
+    }
+  }
+  return true;
+}
+
+void AsyncLogWriter::drain_() {
+  size_t head = head_.load(std::memory_order_relaxed);
+  size_t tail = tail_.load(std::memory_order_acquire);
+  while (head != tail) {
+    size_t count = std::min(tail - head, WRITEV_BATCH_);
+    if (!write_batch_(head, count) && !has_reported_failure_) {
+      // Records are dropped rather than stalling the control loop
+      has_reported_failure_ = true;
+      io::err("[Warning] Unable to write to log file " + path_ + ".");
+    }
+    head += count;
+    head_.store(head, std::memory_order_release);
+    if (head == tail) tail = tail_.load(std::memory_order_acquire);
+  }
+  size_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped != reported_dropped_) {
+    std::string notice = "[Warning] Dropped " +
+                         tools::to_string(dropped - reported_dropped_) +
+                         " log lines while the log writer fell behind.\n";
+    reported_dropped_ = dropped;
+    if (::write(fd_, notice.data(), notice.size()) == -1) {
+      // Dropped like any other record if it cannot be written
+    }
+  }
+}
+
+void AsyncLogWriter::run_() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait_for(lock, FLUSH_INTERVAL_, [this]() {
+        return stop_.load() || flush_requested_.load() ||
+               pending_() >= FLUSH_RECORDS_;
+      });
+      flush_requested_ = false;
+    }
+    drain_();
+    if (stop_.load()) {
+      drain_();
+      return;
+    }
+  }
+}
+
+AsyncLogWriter::AsyncLogWriter(const std::string &path)
+    : path_(path), ring_(CAPACITY_) {
+  ensure_deep_parent(path_);
+  fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_ == -1) {
+    throw error::IOError(path_, "write", "Cannot open log file.");
+  }
+  writer_ = std::thread(&AsyncLogWriter::run_, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+  stop_ = true;
+  wake_writer_();
+  if (writer_.joinable()) writer_.join();
+  ::close(fd_);
+}
+
+bool AsyncLogWriter::push(std::string record) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) >= CAPACITY_) {
+    // The writer was woken FLUSH_RECORDS_ records ago and is behind
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  ring_[tail & (CAPACITY_ - 1)] = std::move(record);
+  tail_.store(tail + 1, std::memory_order_release);
+  if (pending_() == FLUSH_RECORDS_) wake_writer_();
+  return true;
+}
+
+void AsyncLogWriter::flush() {
+  flush_requested_ = true;
+  wake_writer_();
+}
+
+size_t AsyncLogWriter::dropped() const {
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+}  // namespace io
+
+}  // namespace templimiter
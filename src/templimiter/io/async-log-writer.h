@@ -0,0 +1,167 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file async-log-writer.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::AsyncLogWriter class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+/**
+ * @brief Appends preformatted records to a file from a background thread
+ *
+ * Records are passed through a single-producer single-consumer ring buffer;
+ * the data path is lock-free and the mutex is only used for wakeups. The
+ * writer keeps the file open and drains records in batches using writev,
+ * once FLUSH_RECORDS_ are pending, every FLUSH_INTERVAL_, or on flush().
+ *
+ * The producer never waits on the writer, which may run at a lower priority
+ * than a SCHED_FIFO or SCHED_DEADLINE control thread: records pushed while
+ * the ring is full are dropped, and the writer logs how many.
+ */
+class AsyncLogWriter {
+ private:
+  /** @brief Number of ring slots (must be a power of two) */
+  static constexpr size_t CAPACITY_ = 1024;
+
+  /** @brief Number of pending records that wakes the writer early */
+  static constexpr size_t FLUSH_RECORDS_ = 64;
+
+  /** @brief Maximum number of records per writev call */
+  static constexpr size_t WRITEV_BATCH_ = 64;
+
+  /** @brief Longest time a record waits before being written */
+  static constexpr std::chrono::milliseconds FLUSH_INTERVAL_{1000};
+
+  /** @brief Path of the file */
+  std::string path_;
+
+  /** @brief Descriptor held open for appending */
+  int fd_ = -1;
+
+  /** @brief Ring of preformatted records (newline terminated) */
+  std::vector<std::string> ring_;
+
+  /** @brief Number of records written (owned by the writer thread) */
+  std::atomic<size_t> head_{0};
+
+  /** @brief Number of records pushed (owned by the producer) */
+  std::atomic<size_t> tail_{0};
+
+  /** @brief Whether or not the writer has been asked to write now */
+  std::atomic<bool> flush_requested_{false};
+
+  /** @brief Whether or not the writer should exit after draining */
+  std::atomic<bool> stop_{false};
+
+  /** @brief Number of records dropped because the ring was full */
+  std::atomic<size_t> dropped_{0};
+
+  /** @brief Number of dropped records already reported (writer thread) */
+  size_t reported_dropped_ = 0;
+
+  /** @brief Whether or not a write failure has already been reported */
+  bool has_reported_failure_ = false;
+
+  /** @brief Guards the condition variables */
+  std::mutex mutex_;
+
+  /** @brief Wakes the writer thread */
+  std::condition_variable wake_;
+
+  /** @brief Background writer thread */
+  std::thread writer_;
+
+  /**
+   * @brief Returns the number of records waiting to be written
+   * @return size_t
+   */
+  size_t pending_() const;
+
+  /** @brief Wakes the writer thread */
+  void wake_writer_();
+
+  /**
+   * @brief Writes a batch of records, retrying partial writes
+   *
+   * @param first Index of the first record
+   * @param count Number of records
+   * @return true if all records were written
+   * @return false if writing failed
+   */
+  bool write_batch_(size_t first, size_t count);
+
+  /** @brief Writes every pending record, then reports new drops */
+  void drain_();
+
+  /** @brief Writer thread loop */
+  void run_();
+
+ public:
+  /**
+   * @brief Construct a new AsyncLogWriter object and start its thread
+   *
+   * @param path File to append to (created, along with its parent
+   * directories, if it does not exist)
+   * @throw templimiter::error::IOError if the file cannot be opened
+   */
+  explicit AsyncLogWriter(const std::string &path);
+
+  /** @brief Writes all pending records and stops the thread */
+  ~AsyncLogWriter();
+
+  AsyncLogWriter(const AsyncLogWriter &) = delete;
+  AsyncLogWriter &operator=(const AsyncLogWriter &) = delete;
+
+  /**
+   * @brief Queues a record, or drops it if the ring is full; never waits
+   * (must only be called from a single thread)
+   *
+   * @param record Newline terminated record
+   * @return true if the record was queued
+   * @return false if it was dropped
+   */
+  bool push(std::string record);
+
+  /** @brief Wakes the writer to write every queued record now; never waits */
+  void flush();
+
+  /**
+   * @brief Returns the number of records dropped since construction
+   * @return size_t
+   */
+  size_t dropped() const;
+};
+
+}  // namespace io
+
+}  // namespace templimiter
@@ -0,0 +1,78 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file exit-watcher.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ExitWatcher class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/io/exit-watcher.h"
+
+#include <sys/epoll.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <cerrno>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+namespace {
+
+/** @brief Largest number of events collected per epoll_wait call */
+constexpr size_t MAX_EVENTS = 64;
+
+}  // namespace
+
+ExitWatcher::ExitWatcher()
+    : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)), events_(MAX_EVENTS) {}
+
+ExitWatcher::~ExitWatcher() {
+  if (epoll_fd_ != -1) ::close(epoll_fd_);
+}
+
+bool ExitWatcher::add(int pidfd, pid_t pid) {
+  if (epoll_fd_ == -1 || pidfd == -1) return false;
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.u64 = uint64_t(pid);
+  return ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, pidfd, &ev) == 0;
+}
+
+void ExitWatcher::remove(int pidfd) {
+  if (epoll_fd_ == -1 || pidfd == -1) return;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, pidfd, nullptr);
+}
+
+void ExitWatcher::collect_exited(std::vector<pid_t> &exited) {
+  if (epoll_fd_ == -1) return;
+  int n;
+  do {
+    n = ::epoll_wait(epoll_fd_, events_.data(), int(events_.size()), 0);
+  } while (n == -1 && errno == EINTR);
+  // Exited descriptors stay readable until closed; the rest are found later
+  for (int i = 0; i < n; i++) {
+    exited.push_back(pid_t(events_[size_t(i)].data.u64));
+  }
+}
+
+}  // namespace io
+
+}  // namespace templimiter
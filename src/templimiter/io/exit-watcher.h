@@ -0,0 +1,86 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file exit-watcher.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ExitWatcher class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/epoll.h>
+#include <sys/types.h>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+/**
+ * @brief Reports process exits by polling process descriptors (pidfds) with
+ * epoll; a pidfd becomes readable once its process exits
+ */
+class ExitWatcher {
+ private:
+  /** @brief epoll descriptor, or -1 if unavailable */
+  int epoll_fd_ = -1;
+
+  /** @brief Reusable event buffer */
+  std::vector<epoll_event> events_;
+
+ public:
+  /** @brief Construct a new ExitWatcher object */
+  ExitWatcher();
+
+  /** @brief Destroy the ExitWatcher object */
+  ~ExitWatcher();
+
+  ExitWatcher(const ExitWatcher &) = delete;
+  ExitWatcher &operator=(const ExitWatcher &) = delete;
+
+  /**
+   * @brief Starts watching a process descriptor
+   *
+   * @param pidfd Process descriptor
+   * @param pid Pid reported when the process exits
+   * @return true if watched
+   * @return false if epoll is unavailable or the descriptor was rejected
+   */
+  bool add(int pidfd, pid_t pid);
+
+  /**
+   * @brief Stops watching a process descriptor (closing a descriptor also
+   * stops watching it)
+   *
+   * @param pidfd Process descriptor
+   */
+  void remove(int pidfd);
+
+  /**
+   * @brief Collects the pids of watched processes that have exited, without
+   * blocking
+   *
+   * @param exited Pids of exited processes (appended)
+   */
+  void collect_exited(std::vector<pid_t> &exited);
+};
+
+}  // namespace io
+
+}  // namespace templimiter
@@ -19,7 +19,7 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides the templimiter::io::FileCollection template class
  * @date created 2019-02-06
- * @date modified 2019-02-06
+ * @date modified 2026-10-14
  */
 
 #pragma once
@@ -70,12 +70,15 @@ class FileCollection {
    *
    * @param file_paths Vector of file paths to create templimiter::io::File
    * objects with
+   * @param persistent Whether or not the files should be read through
+   * persistent descriptors
    * @throw templimiter::error::ArgumentError if file_paths.size() == 0
    */
-  FileCollection(const std::vector<std::string> &file_paths) {
+  FileCollection(const std::vector<std::string> &file_paths,
+                 bool persistent = false) {
     if (file_paths.size() > 0) {
       for (const auto &path : file_paths) {
-        files_.push_back(std::make_shared<File<T>>(path));
+        files_.push_back(std::make_shared<File<T>>(path, persistent));
       }
     } else {
       throw error::ArgumentError(
@@ -89,14 +92,16 @@ class FileCollection {
    *
    * @param pattern Pattern to match files to and create templimiter::io::File
    * objects with
+   * @param persistent Whether or not the files should be read through
+   * persistent descriptors
    * @throw templimiter::error::ArgumentError if no file paths were found given
    * the matcher.
    */
-  FileCollection(const std::string &pattern) {
+  FileCollection(const std::string &pattern, bool persistent = false) {
     std::vector<std::string> results = ls(pattern);
     if (results.size() > 0) {
       for (const auto &path : results) {
-        files_.push_back(std::make_shared<File<T>>(path));
+        files_.push_back(std::make_shared<File<T>>(path, persistent));
       }
     } else {
       throw error::ArgumentError(
@@ -112,6 +117,32 @@ class FileCollection {
   /** @brief Returns the number of contained file objects */
   size_t size() { return files_.size(); }
 
+  /**
+   * @brief Returns the paths of all files
+   *
+   * @return std::vector<std::string>
+   */
+  std::vector<std::string> paths() const {
+    std::vector<std::string> file_paths;
+    for (const auto &file : files_) {
+      file_paths.push_back(file->path());
+    }
+    return file_paths;
+  }
+
+  /**
+   * @brief Returns the persistent read descriptors of all files
+   *
+   * @return std::vector<int> Descriptors (-1 for files without one)
+   */
+  std::vector<int> descriptors() const {
+    std::vector<int> fds;
+    for (const auto &file : files_) {
+      fds.push_back(file->descriptor());
+    }
+    return fds;
+  }
+
   /**
    * @brief Updates contents_ and returns a reference to it
    *
@@ -122,6 +153,13 @@ class FileCollection {
     return contents_;
   }
 
+  /**
+   * @brief Returns the contents from the last read without rereading
+   *
+   * @return const std::vector<T>&
+   */
+  const std::vector<T> &contents() const { return contents_; }
+
   /**
    * @brief Appends a line to all files
    *
@@ -180,6 +218,46 @@ class FileCollection {
     }
   }
 
+  /**
+   * @brief Overwrites each file with its own line in one pass
+   *
+   * @param lines One line per file, in file order
+   * @throw templimiter::error::ArgumentError if the number of lines does not
+   * match the number of files
+   */
+  void overwrite_each(const std::vector<T> &lines) {
+    if (lines.size() != files_.size()) {
+      throw error::ArgumentError(
+          "lines", "std::vector", "{ 2400000, 2400000 }",
+          "Number of lines must match FileCollection size.");
+    }
+    for (size_t i = 0; i < files_.size(); i++) {
+      files_[i]->overwrite(lines[i]);
+    }
+  }
+
+  /**
+   * @brief Overwrites a subset of files with their own lines in one pass
+   *
+   * @param file_indices Indices of files chosen
+   * @param lines One line per chosen file
+   * @throw templimiter::error::ArgumentError if the number of lines does not
+   * match the number of indices
+   * @throw templimiter::error::ArgumentError if any index is greater than
+   * number of files present.
+   */
+  void overwrite_each(const std::vector<size_t> &file_indices,
+                      const std::vector<T> &lines) {
+    if (lines.size() != file_indices.size()) {
+      throw error::ArgumentError(
+          "lines", "std::vector", "{ 2400000, 2400000 }",
+          "Number of lines must match the number of file indices.");
+    }
+    for (size_t i = 0; i < file_indices.size(); i++) {
+      overwrite(file_indices[i], lines[i]);
+    }
+  }
+
   /**
    * @brief Finds the maximum value of any line retrieved from all files
    *
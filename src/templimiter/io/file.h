@@ -15,19 +15,27 @@
 */
 
 /**
- * @file file-collection.h
+ * @file file.h
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides the templimiter::io::File template class
  * @date created 2019-02-06
- * @date modified 2019-02-09
+ * @date modified 2026-10-14
  */
 
 #pragma once
 
+#include <fcntl.h>
+#include <linux/magic.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "templimiter/error/argument-error.h"
@@ -68,6 +76,30 @@ class File {
   /** @brief Whether or not the file exists */
   bool exists_ = false;
 
+  /**
+   * @brief Whether or not reads and integer overwrites keep descriptors open
+   * between calls (used for sysfs/procfs files accessed on every iteration)
+   */
+  bool is_persistent_ = false;
+
+  /** @brief Descriptor held open for persistent reads */
+  int read_fd_ = -1;
+
+  /** @brief Descriptor held open for persistent overwrites */
+  int write_fd_ = -1;
+
+  /**
+   * @brief Whether or not write_fd_ refers to sysfs, where a write at offset
+   * zero replaces the value and no truncation is needed
+   */
+  bool is_sysfs_write_ = false;
+
+  /** @brief Size of the stack buffer used for persistent reads */
+  static constexpr size_t PREAD_BUF_SIZE_ = 4096;
+
+  /** @brief Size of the stack buffer used for persistent overwrites */
+  static constexpr size_t PWRITE_BUF_SIZE_ = 32;
+
   /**
    * @brief Asserts that the provided file path is a valid absolute filepath
    * @throw templimiter::error::ArgumentError if path_ is blank
@@ -151,8 +183,151 @@ class File {
     }
   }
 
+  /** @brief Closes the persistent read descriptor, if open */
+  void close_fd_() {
+    if (read_fd_ != -1) {
+      ::close(read_fd_);
+      read_fd_ = -1;
+    }
+  }
+
+  /**
+   * @brief Opens the persistent read descriptor
+   * @throw templimiter::error::IOError if the file cannot be opened
+   */
+  void open_fd_() {
+    close_fd_();
+    read_fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (read_fd_ == -1) {
+      if (errno == ENOENT) {
+        throw error::IOError(path_, "read", "File does not exist.");
+      }
+      throw error::IOError(path_, "read");
+    }
+  }
+
+  /** @brief Closes the persistent write descriptor, if open */
+  void close_write_fd_() {
+    if (write_fd_ != -1) {
+      ::close(write_fd_);
+      write_fd_ = -1;
+    }
+  }
+
+  /**
+   * @brief Opens the persistent write descriptor (the file is never created)
+   * @throw templimiter::error::IOError if the file cannot be opened
+   */
+  void open_write_fd_() {
+    close_write_fd_();
+    write_fd_ = ::open(path_.c_str(), O_WRONLY | O_CLOEXEC);
+    if (write_fd_ == -1) {
+      if (errno == ENOENT) {
+        throw error::IOError(path_, "write", "File does not exist.");
+      }
+      throw error::IOError(path_, "write");
+    }
+    struct statfs fs;
+    is_sysfs_write_ =
+        ::fstatfs(write_fd_, &fs) == 0 && fs.f_type == SYSFS_MAGIC;
+  }
+
+  /**
+   * @brief Overwrites the file with one integer line using a single pwrite on
+   * the persistent descriptor, reopening once if it has gone stale
+   *
+   * @param data Data to overwrite with
+   * @throw templimiter::error::IOError if writing fails
+   */
+  void pwrite_(const T &data) {
+    char buf[PWRITE_BUF_SIZE_];
+    auto result = std::to_chars(buf, buf + sizeof(buf) - 1, data);
+    *result.ptr = '\n';
+    size_t len = size_t(result.ptr - buf) + 1;
+
+    if (write_fd_ == -1) open_write_fd_();
+    ssize_t n = ::pwrite(write_fd_, buf, len, 0);
+    if (n == -1 && (errno == ESTALE || errno == ENOENT || errno == ENODEV)) {
+      // the file has been recreated (e.g. cpu hotplug); reopen and retry once
+      open_write_fd_();
+      n = ::pwrite(write_fd_, buf, len, 0);
+    }
+    if (n != ssize_t(len) ||
+        (!is_sysfs_write_ && ::ftruncate(write_fd_, off_t(len)) == -1)) {
+      close_write_fd_();
+      throw error::IOError(path_, "write", "Cannot overwrite file.");
+    }
+  }
+
+  /**
+   * @brief Reads the whole file from offset zero using the persistent
+   * descriptor, reopening once if the descriptor has gone stale
+   *
+   * @param buf Buffer to read into (PREAD_BUF_SIZE_ bytes)
+   * @return size_t Number of bytes read
+   * @throw templimiter::error::IOError if reading fails
+   * @throw templimiter::error::IOError if the file does not fit in the buffer
+   */
+  size_t pread_(char *buf) {
+    if (read_fd_ == -1) open_fd_();
+    ssize_t n = ::pread(read_fd_, buf, PREAD_BUF_SIZE_, 0);
+    if (n == -1 && (errno == ESTALE || errno == ENOENT || errno == ENODEV)) {
+      // the file has been recreated (e.g. cpu hotplug); reopen and retry once
+      open_fd_();
+      n = ::pread(read_fd_, buf, PREAD_BUF_SIZE_, 0);
+    }
+    if (n == -1) {
+      int saved = errno;
+      close_fd_();
+      if (saved == ENOENT) {
+        throw error::IOError(path_, "read", "File does not exist.");
+      }
+      throw error::IOError(path_, "read");
+    }
+    if (size_t(n) == PREAD_BUF_SIZE_) {
+      throw error::IOError(path_, "read",
+                           "File is too large for a persistent read.");
+    }
+    return size_t(n);
+  }
+
+  /**
+   * @brief Converts one line of a persistent read, parsing integers directly
+   *
+   * @param first First character of the line
+   * @param last One past the last character of the line
+   * @return T
+   * @throw templimiter::error::TypeError if the line cannot be converted
+   */
+  T convert_line_(const char *first, const char *last) {
+    if constexpr (tools::is_numeric_integral_v<T>) {
+      return tools::convert<T>(std::string_view(first, size_t(last - first)));
+    } else {
+      std::string line(first, last);
+      return tools::convert<T>(line, std::streamsize(line.size()));
+    }
+  }
+
+  /** @brief Updates contents_ using the persistent descriptor */
+  void pread_to_contents_() {
+    char buf[PREAD_BUF_SIZE_];
+    size_t n = pread_(buf);
+    contents_.clear();
+    const char *cur = buf;
+    const char *end = buf + n;
+    while (cur < end) {
+      const char *eol = std::find(cur, end, '\n');
+      contents_.push_back(convert_line_(cur, eol));
+      cur = eol + 1;
+    }
+  }
+
   /** @brief Updates contents_ */
   void read_to_contents_() {
+    if (is_persistent_) {
+      pread_to_contents_();
+      return;
+    }
     open_read_();
     std::string line;
     contents_.clear();
@@ -191,9 +366,14 @@ class File {
    * @brief Construct a new File object
    *
    * @param file_path File path to construct file with
+   * @param persistent Whether or not to keep descriptors open and use
+   * pread/pwrite instead of reopening the file each time (integer overwrites
+   * then require the file to exist and skip parent directory creation)
    */
-  explicit File(const std::string &file_path)
-      : path_(file_path), exists_(file_exists(file_path)) {
+  explicit File(const std::string &file_path, bool persistent = false)
+      : path_(file_path),
+        exists_(file_exists(file_path)),
+        is_persistent_(persistent) {
     validate_();
   }
 
@@ -201,6 +381,8 @@ class File {
   ~File() {
     close_read_();
     close_write_();
+    close_fd_();
+    close_write_fd_();
   }
 
   /** @brief Gets whether or not the file exists */
@@ -209,6 +391,13 @@ class File {
   /** @brief Gets the file path */
   const std::string &path() const { return path_; }
 
+  /**
+   * @brief Gets the persistent read descriptor (used for polling)
+   *
+   * @return int Descriptor, or -1 if not persistent or not yet read
+   */
+  int descriptor() const { return read_fd_; }
+
   /**
    * @brief Updates contents_ and returns a reference to it
    *
@@ -303,12 +492,19 @@ class File {
   }
 
   /**
-   * @brief Overwrites all data in a file
+   * @brief Overwrites all data in a file (with a single pwrite when the file
+   * is persistent and T is an integer)
    *
    * @param data Data to overwrite with
    * @throw templimiter::error::IOError if writing to the write_stream_ fails
    */
   void overwrite(const T &data) {
+    if constexpr (tools::is_numeric_integral_v<T>) {
+      if (is_persistent_) {
+        pwrite_(data);
+        return;
+      }
+    }
     open_write_(false);
     try {
       write_stream_ << data << std::endl;
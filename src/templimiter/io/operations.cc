@@ -24,8 +24,12 @@
 
 #include "templimiter/io/operations.h"
 
+#include <fcntl.h>
 #include <glob.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -60,7 +64,15 @@ void out_helptext() {
       "  -v --version\n"
       "         Print the version number and exit.\n"
       "  -h --which-conf\n"
-      "         Print the configuration file path and exit.";
+      "         Print the configuration file path and exit.\n"
+      "  --release\n"
+      "         Release the limits left behind by a templimiter that was "
+      "killed, and exit.\n"
+      "  --dump-telemetry [path]\n"
+      "         Print the telemetry file (default: telemetry_file_path) as "
+      "CSV and exit.\n"
+      "  --dump-telemetry-json [path]\n"
+      "         Print the telemetry file as JSON and exit.";
   std::cout << helptext << std::endl;
 }
 
@@ -102,6 +114,35 @@ void ensure_deep_parent(const std::string &file_path) {
   }
 }
 
+bool replace_file(const std::string &file_path, const std::string &text) {
+  std::string tmp_path = file_path + ".tmp";
+  int fd =
+      ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd == -1) return false;
+  size_t written = 0;
+  while (written < text.size()) {
+    ssize_t n = ::write(fd, text.data() + written, text.size() - written);
+    if (n == -1 && errno == EINTR) continue;
+    if (n <= 0) {
+      // A write that makes no progress sets no errno
+      int write_errno = n == 0 ? ENOSPC : errno;
+      ::close(fd);
+      std::remove(tmp_path.c_str());
+      errno = write_errno;
+      return false;
+    }
+    written += size_t(n);
+  }
+  ::close(fd);
+  if (::rename(tmp_path.c_str(), file_path.c_str()) == -1) {
+    int rename_errno = errno;
+    std::remove(tmp_path.c_str());
+    errno = rename_errno;
+    return false;
+  }
+  return true;
+}
+
 std::vector<std::string> ls(const std::string &pattern, bool include_paths) {
   std::vector<std::string> files;
   glob_t glob_result;
@@ -226,6 +226,18 @@ void mkdir_deep(const std::string &dir_path);
  */
 void ensure_deep_parent(const std::string &file_path);
 
+/**
+ * @brief Replaces a file atomically: the text is written to a temporary file
+ * next to it, which is then renamed over it, so that readers never see a
+ * partial file
+ *
+ * @param file_path File path to replace
+ * @param text New contents
+ * @return true if replaced
+ * @return false if the file could not be written (errno is set)
+ */
+bool replace_file(const std::string &file_path, const std::string &text);
+
 /**
  * @brief Returns a list of files that match the provided pattern using glob
  *
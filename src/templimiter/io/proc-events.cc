@@ -0,0 +1,154 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file proc-events.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ProcEvents class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/io/proc-events.h"
+
+#include <fcntl.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+namespace {
+
+/** @brief Size of the netlink receive buffer */
+constexpr size_t RECV_BUF_SIZE = 65536;
+
+/** @brief Requested socket receive queue size, absorbing bursts of churn */
+constexpr int RECV_QUEUE_SIZE = 1 << 20;
+
+}  // namespace
+
+bool ProcEvents::send_op_(int op) {
+  // cn_msg ends in a flexible array, so the request is laid out by hand
+  alignas(nlmsghdr) char req[NLMSG_SPACE(sizeof(cn_msg) + sizeof(int))];
+  std::memset(req, 0, sizeof(req));
+  auto *hdr = reinterpret_cast<nlmsghdr *>(req);
+  hdr->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(int));
+  hdr->nlmsg_type = NLMSG_DONE;
+  auto *msg = static_cast<cn_msg *>(NLMSG_DATA(hdr));
+  msg->id.idx = CN_IDX_PROC;
+  msg->id.val = CN_VAL_PROC;
+  msg->len = sizeof(int);
+  std::memcpy(msg->data, &op, sizeof(int));
+  return ::send(nl_fd_, req, hdr->nlmsg_len, 0) == ssize_t(hdr->nlmsg_len);
+}
+
+bool ProcEvents::open_netlink_() {
+  nl_fd_ = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                    NETLINK_CONNECTOR);
+  if (nl_fd_ == -1) return false;
+  ::setsockopt(nl_fd_, SOL_SOCKET, SO_RCVBUF, &RECV_QUEUE_SIZE,
+               sizeof(RECV_QUEUE_SIZE));
+
+  sockaddr_nl local;
+  std::memset(&local, 0, sizeof(local));
+  local.nl_family = AF_NETLINK;
+  local.nl_groups = CN_IDX_PROC;
+  if (::bind(nl_fd_, reinterpret_cast<sockaddr *>(&local), sizeof(local)) ==
+          -1 ||
+      !send_op_(PROC_CN_MCAST_LISTEN)) {
+    ::close(nl_fd_);
+    nl_fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+ProcEvents::ProcEvents() : recv_buf_(RECV_BUF_SIZE) { open_netlink_(); }
+
+ProcEvents::~ProcEvents() {
+  if (nl_fd_ != -1) {
+    send_op_(PROC_CN_MCAST_IGNORE);
+    ::close(nl_fd_);
+  }
+}
+
+bool ProcEvents::is_available() const { return nl_fd_ != -1; }
+
+bool ProcEvents::drain(std::vector<pid_t> &started,
+                       std::vector<pid_t> &exited) {
+  if (nl_fd_ == -1) return false;
+  bool complete = true;
+  while (true) {
+    ssize_t n = ::recv(nl_fd_, recv_buf_.data(), recv_buf_.size(), 0);
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      if (errno == ENOBUFS) {
+        // The queue overran; the caller must rescan to catch up
+        complete = false;
+        continue;
+      }
+      break;
+    }
+    if (n == 0) break;
+    size_t len = size_t(n);
+    for (auto *hdr = reinterpret_cast<nlmsghdr *>(recv_buf_.data());
+         NLMSG_OK(hdr, len); hdr = NLMSG_NEXT(hdr, len)) {
+      if (hdr->nlmsg_type == NLMSG_ERROR || hdr->nlmsg_type == NLMSG_NOOP) {
+        continue;
+      }
+      const auto *msg = static_cast<const cn_msg *>(NLMSG_DATA(hdr));
+      if (msg->id.idx != CN_IDX_PROC || msg->id.val != CN_VAL_PROC ||
+          msg->len < sizeof(proc_event)) {
+        continue;
+      }
+      proc_event ev;
+      std::memcpy(&ev, msg->data, sizeof(ev));
+      switch (ev.what) {
+        case proc_event::PROC_EVENT_FORK:
+          // Threads share their parent's tgid and are not processes
+          if (ev.event_data.fork.child_pid == ev.event_data.fork.child_tgid) {
+            started.push_back(ev.event_data.fork.child_pid);
+          }
+          break;
+        case proc_event::PROC_EVENT_EXEC:
+          started.push_back(ev.event_data.exec.process_tgid);
+          break;
+        case proc_event::PROC_EVENT_EXIT:
+          if (ev.event_data.exit.process_pid ==
+              ev.event_data.exit.process_tgid) {
+            exited.push_back(ev.event_data.exit.process_pid);
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  return complete;
+}
+
+}  // namespace io
+
+}  // namespace templimiter
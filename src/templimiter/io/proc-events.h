@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file proc-events.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ProcEvents class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+/**
+ * @brief Receives process fork, exec, and exit events from the kernel proc
+ * connector (NETLINK_CONNECTOR, CN_IDX_PROC; requires CAP_NET_ADMIN)
+ */
+class ProcEvents {
+ private:
+  /** @brief Connector socket, or -1 if unavailable */
+  int nl_fd_ = -1;
+
+  /** @brief Receive buffer for netlink messages */
+  std::vector<char> recv_buf_;
+
+  /**
+   * @brief Opens the connector socket and subscribes to process events
+   *
+   * @return true if subscribed
+   * @return false if the proc connector is not available
+   */
+  bool open_netlink_();
+
+  /**
+   * @brief Sends a multicast operation to the proc connector
+   *
+   * @param op PROC_CN_MCAST_LISTEN or PROC_CN_MCAST_IGNORE
+   * @return true if sent
+   * @return false if the send failed
+   */
+  bool send_op_(int op);
+
+ public:
+  /** @brief Construct a new ProcEvents object */
+  ProcEvents();
+
+  /** @brief Destroy the ProcEvents object */
+  ~ProcEvents();
+
+  ProcEvents(const ProcEvents &) = delete;
+  ProcEvents &operator=(const ProcEvents &) = delete;
+
+  /**
+   * @brief Returns whether or not process events are being received
+   *
+   * @return true if subscribed to the proc connector
+   * @return false if unavailable
+   */
+  bool is_available() const;
+
+  /**
+   * @brief Reads all pending events without blocking
+   *
+   * Only events of whole processes (thread group leaders) are reported.
+   *
+   * @param started Pids of processes that were forked or exec'd (appended)
+   * @param exited Pids of processes that exited (appended)
+   * @return true if no events were lost
+   * @return false if the receive queue overran and events were dropped
+   */
+  bool drain(std::vector<pid_t> &started, std::vector<pid_t> &exited);
+};
+
+}  // namespace io
+
+}  // namespace templimiter
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file proc-scanner.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ProcScanner class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/io/proc-scanner.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "templimiter/error/io-error.h"
+
+namespace templimiter {
+
+namespace io {
+
+namespace {
+
+/** @brief Size of the directory entry buffer */
+constexpr size_t DENTS_BUF_SIZE = 32768;
+
+/** @brief Size of the stat file buffer */
+constexpr size_t STAT_BUF_SIZE = 4096;
+
+}  // namespace
+
+void ProcScanner::open_dir_() {
+  if (dir_fd_ != -1) return;
+  dir_fd_ = ::open(proc_path_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dir_fd_ == -1) {
+    throw error::IOError(proc_path_, "open", "Cannot open proc directory.");
+  }
+}
+
+bool ProcScanner::fill_dents_() {
+  long n = ::syscall(SYS_getdents64, dir_fd_, dents_buf_.data(),
+                     dents_buf_.size());
+  if (n == -1) {
+    throw error::IOError(proc_path_, "getdents64");
+  }
+  dents_len_ = size_t(n);
+  dents_pos_ = 0;
+  return n > 0;
+}
+
+bool ProcScanner::read_stat_(const char *name, std::string_view &stat) {
+  char path[32];
+  size_t name_len = std::strlen(name);
+  if (name_len + sizeof("/stat") > sizeof(path)) return false;
+  std::memcpy(path, name, name_len);
+  std::memcpy(path + name_len, "/stat", sizeof("/stat"));
+
+  int fd = ::openat(dir_fd_, path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) return false;
+  size_t len = 0;
+  while (len < stat_buf_.size()) {
+    ssize_t n = ::read(fd, stat_buf_.data() + len, stat_buf_.size() - len);
+    if (n == -1 && errno == EINTR) continue;
+    if (n <= 0) {
+      if (n == -1) len = 0;
+      break;
+    }
+    len += size_t(n);
+  }
+  ::close(fd);
+  if (len == 0) return false;
+  stat = std::string_view(stat_buf_.data(), len);
+  return true;
+}
+
+ProcScanner::ProcScanner(const std::string &proc_path)
+    : proc_path_(proc_path),
+      dents_buf_(DENTS_BUF_SIZE),
+      stat_buf_(STAT_BUF_SIZE) {}
+
+ProcScanner::~ProcScanner() {
+  if (dir_fd_ != -1) ::close(dir_fd_);
+}
+
+void ProcScanner::rewind() {
+  open_dir_();
+  if (::lseek(dir_fd_, 0, SEEK_SET) == -1) {
+    throw error::IOError(proc_path_, "seek");
+  }
+  dents_len_ = 0;
+  dents_pos_ = 0;
+}
+
+bool ProcScanner::next_entry_(const char *&name, pid_t &pid) {
+  while (true) {
+    if (dents_pos_ >= dents_len_ && !fill_dents_()) return false;
+    const auto *ent =
+        reinterpret_cast<const struct dirent64 *>(&dents_buf_[dents_pos_]);
+    dents_pos_ += ent->d_reclen;
+
+    // Only numeric directories are processes
+    if (ent->d_type != DT_DIR && ent->d_type != DT_UNKNOWN) continue;
+    name = ent->d_name;
+    const char *name_end = name + std::strlen(name);
+    auto result = std::from_chars(name, name_end, pid);
+    if (name == name_end || result.ec != std::errc() ||
+        result.ptr != name_end) {
+      continue;
+    }
+    return true;
+  }
+}
+
+bool ProcScanner::next(pid_t &pid, std::string_view &stat) {
+  const char *name;
+  while (next_entry_(name, pid)) {
+    if (read_stat_(name, stat)) return true;
+  }
+  return false;
+}
+
+bool ProcScanner::next_pid(pid_t &pid) {
+  const char *name;
+  return next_entry_(name, pid);
+}
+
+bool ProcScanner::read_stat(pid_t pid, std::string_view &stat) {
+  open_dir_();
+  char name[16];
+  auto result = std::to_chars(name, name + sizeof(name) - 1, pid);
+  *result.ptr = '\0';
+  return read_stat_(name, stat);
+}
+
+}  // namespace io
+
+}  // namespace templimiter
@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file proc-scanner.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ProcScanner class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+/**
+ * @brief Walks the process table in a single pass using getdents64 on one
+ * open directory descriptor, reading each stat file into a reusable buffer
+ */
+class ProcScanner {
+ private:
+  /** @brief Location of the proc filesystem */
+  std::string proc_path_;
+
+  /** @brief Descriptor of the open proc directory */
+  int dir_fd_ = -1;
+
+  /** @brief Reusable buffer for directory entries */
+  std::vector<char> dents_buf_;
+
+  /** @brief Number of valid bytes in dents_buf_ */
+  size_t dents_len_ = 0;
+
+  /** @brief Position of the next unread entry in dents_buf_ */
+  size_t dents_pos_ = 0;
+
+  /** @brief Reusable buffer for stat file contents */
+  std::vector<char> stat_buf_;
+
+  /**
+   * @brief Opens the proc directory descriptor, if not open
+   * @throw templimiter::error::IOError if the directory cannot be opened
+   */
+  void open_dir_();
+
+  /**
+   * @brief Refills dents_buf_ with the next batch of directory entries
+   *
+   * @return true if entries were read
+   * @return false if the end of the directory has been reached
+   * @throw templimiter::error::IOError if getdents64 fails
+   */
+  bool fill_dents_();
+
+  /**
+   * @brief Advances to the next numeric directory entry
+   *
+   * @param name NUL-terminated pid directory name (valid until the next
+   * call)
+   * @param pid Pid of the process found
+   * @return true if a process was found
+   * @return false if the scan has finished
+   */
+  bool next_entry_(const char *&name, pid_t &pid);
+
+  /**
+   * @brief Reads the stat file of a process relative to the proc directory
+   *
+   * @param name NUL-terminated pid directory name
+   * @param stat View of the stat file contents (valid until the next read)
+   * @return true if the stat file was read
+   * @return false if the process no longer exists
+   */
+  bool read_stat_(const char *name, std::string_view &stat);
+
+ public:
+  /**
+   * @brief Construct a new ProcScanner object
+   *
+   * @param proc_path Location of the proc filesystem
+   */
+  explicit ProcScanner(const std::string &proc_path = "/proc");
+
+  /** @brief Destroy the ProcScanner object */
+  ~ProcScanner();
+
+  ProcScanner(const ProcScanner &) = delete;
+  ProcScanner &operator=(const ProcScanner &) = delete;
+
+  /** @brief Restarts the scan from the first process */
+  void rewind();
+
+  /**
+   * @brief Advances to the next process and reads its stat file
+   *
+   * @param pid Pid of the process found
+   * @param stat View of the stat file contents (valid until the next call)
+   * @return true if a process was found
+   * @return false if the scan has finished
+   */
+  bool next(pid_t &pid, std::string_view &stat);
+
+  /**
+   * @brief Advances to the next process without reading its stat file
+   *
+   * @param pid Pid of the process found
+   * @return true if a process was found
+   * @return false if the scan has finished
+   */
+  bool next_pid(pid_t &pid);
+
+  /**
+   * @brief Reads the stat file of a single process
+   *
+   * @param pid Pid to read
+   * @param stat View of the stat file contents (valid until the next read)
+   * @return true if the stat file was read
+   * @return false if the process does not exist
+   */
+  bool read_stat(pid_t pid, std::string_view &stat);
+};
+
+}  // namespace io
+
+}  // namespace templimiter
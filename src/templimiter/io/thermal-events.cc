@@ -0,0 +1,251 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thermal-events.cc
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ThermalEvents class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#include "templimiter/io/thermal-events.h"
+
+#include <fcntl.h>
+#include <linux/genetlink.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+namespace {
+
+/** @brief Name of the thermal generic netlink family */
+constexpr std::string_view THERMAL_FAMILY_NAME = "thermal";
+
+/** @brief Thermal multicast group carrying trip point and zone events */
+constexpr std::string_view THERMAL_EVENT_GROUP = "event";
+
+/** @brief Thermal multicast group carrying temperature samples */
+constexpr std::string_view THERMAL_SAMPLING_GROUP = "sampling";
+
+/** @brief Size of the netlink receive buffer */
+constexpr size_t RECV_BUF_SIZE = 8192;
+
+/**
+ * @brief Calls a function for every netlink attribute in a buffer
+ *
+ * @param data First attribute
+ * @param len Length of all attributes
+ * @param fn Function called with (type, payload, payload length)
+ */
+template <typename F>
+void for_each_attr(const char *data, size_t len, F fn) {
+  while (len >= NLA_HDRLEN) {
+    const auto *attr = reinterpret_cast<const nlattr *>(data);
+    if (attr->nla_len < NLA_HDRLEN || attr->nla_len > len) return;
+    fn(attr->nla_type & NLA_TYPE_MASK, data + NLA_HDRLEN,
+       size_t(attr->nla_len - NLA_HDRLEN));
+    size_t step = NLA_ALIGN(attr->nla_len);
+    if (step >= len) return;
+    data += step;
+    len -= step;
+  }
+}
+
+/**
+ * @brief Reads a NUL-terminated string attribute payload
+ *
+ * @param payload Attribute payload
+ * @param len Payload length
+ * @return std::string_view
+ */
+std::string_view attr_string(const char *payload, size_t len) {
+  return std::string_view(payload, strnlen(payload, len));
+}
+
+}  // namespace
+
+bool ThermalEvents::resolve_family_(std::vector<uint32_t> &group_ids) {
+  // Build a CTRL_CMD_GETFAMILY request for the thermal family
+  struct {
+    nlmsghdr hdr;
+    genlmsghdr genl;
+    char attrs[64];
+  } req;
+  std::memset(&req, 0, sizeof(req));
+  req.hdr.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+  req.hdr.nlmsg_type = GENL_ID_CTRL;
+  req.hdr.nlmsg_flags = NLM_F_REQUEST;
+  req.hdr.nlmsg_seq = 1;
+  req.genl.cmd = CTRL_CMD_GETFAMILY;
+  req.genl.version = 1;
+  auto *attr = reinterpret_cast<nlattr *>(reinterpret_cast<char *>(&req) +
+                                          NLMSG_ALIGN(req.hdr.nlmsg_len));
+  attr->nla_type = CTRL_ATTR_FAMILY_NAME;
+  attr->nla_len = uint16_t(NLA_HDRLEN + THERMAL_FAMILY_NAME.size() + 1);
+  std::memcpy(reinterpret_cast<char *>(attr) + NLA_HDRLEN,
+              THERMAL_FAMILY_NAME.data(), THERMAL_FAMILY_NAME.size());
+  req.hdr.nlmsg_len = NLMSG_ALIGN(req.hdr.nlmsg_len) + NLA_ALIGN(attr->nla_len);
+
+  sockaddr_nl kernel;
+  std::memset(&kernel, 0, sizeof(kernel));
+  kernel.nl_family = AF_NETLINK;
+  if (::sendto(nl_fd_, &req, req.hdr.nlmsg_len, 0,
+               reinterpret_cast<sockaddr *>(&kernel), sizeof(kernel)) == -1) {
+    return false;
+  }
+
+  ssize_t n;
+  do {
+    n = ::recv(nl_fd_, recv_buf_.data(), recv_buf_.size(), 0);
+  } while (n == -1 && errno == EINTR);
+  if (n <= 0) return false;
+
+  // Parse the family id and the multicast groups from the reply
+  size_t len = size_t(n);
+  for (auto *hdr = reinterpret_cast<nlmsghdr *>(recv_buf_.data());
+       NLMSG_OK(hdr, len); hdr = NLMSG_NEXT(hdr, len)) {
+    if (hdr->nlmsg_type == NLMSG_ERROR) return false;
+    if (hdr->nlmsg_type != GENL_ID_CTRL) continue;
+    const char *attrs =
+        static_cast<const char *>(NLMSG_DATA(hdr)) + GENL_HDRLEN;
+    size_t attrs_len = hdr->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN);
+    for_each_attr(attrs, attrs_len, [&](int type, const char *p, size_t l) {
+      if (type == CTRL_ATTR_FAMILY_ID && l >= sizeof(uint16_t)) {
+        std::memcpy(&family_id_, p, sizeof(uint16_t));
+      } else if (type == CTRL_ATTR_MCAST_GROUPS) {
+        for_each_attr(p, l, [&](int, const char *grp, size_t grp_len) {
+          std::string_view name;
+          uint32_t id = 0;
+          bool has_id = false;
+          for_each_attr(grp, grp_len, [&](int t, const char *v, size_t vl) {
+            if (t == CTRL_ATTR_MCAST_GRP_NAME) {
+              name = attr_string(v, vl);
+            } else if (t == CTRL_ATTR_MCAST_GRP_ID && vl >= sizeof(id)) {
+              std::memcpy(&id, v, sizeof(id));
+              has_id = true;
+            }
+          });
+          if (has_id && (name == THERMAL_EVENT_GROUP ||
+                         name == THERMAL_SAMPLING_GROUP)) {
+            group_ids.push_back(id);
+          }
+        });
+      }
+    });
+  }
+  return family_id_ != 0;
+}
+
+bool ThermalEvents::open_netlink_() {
+  nl_fd_ = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+  if (nl_fd_ == -1) return false;
+
+  // Bound the family query so that a silent kernel cannot hang startup
+  timeval tv{1, 0};
+  ::setsockopt(nl_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  sockaddr_nl local;
+  std::memset(&local, 0, sizeof(local));
+  local.nl_family = AF_NETLINK;
+  std::vector<uint32_t> group_ids;
+  bool joined = false;
+  if (::bind(nl_fd_, reinterpret_cast<sockaddr *>(&local), sizeof(local)) ==
+          0 &&
+      resolve_family_(group_ids)) {
+    for (uint32_t id : group_ids) {
+      if (::setsockopt(nl_fd_, SOL_NETLINK, NETLINK_ADD_MEMBERSHIP, &id,
+                       sizeof(id)) == 0) {
+        joined = true;
+      }
+    }
+  }
+  if (!joined) {
+    ::close(nl_fd_);
+    nl_fd_ = -1;
+    return false;
+  }
+  ::fcntl(nl_fd_, F_SETFL, ::fcntl(nl_fd_, F_GETFL) | O_NONBLOCK);
+  return true;
+}
+
+bool ThermalEvents::drain_netlink_() {
+  bool received = false;
+  while (true) {
+    ssize_t n = ::recv(nl_fd_, recv_buf_.data(), recv_buf_.size(), 0);
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      // Dropped messages still mean that something happened
+      if (errno == ENOBUFS) {
+        received = true;
+        continue;
+      }
+      break;
+    }
+    if (n == 0) break;
+    size_t len = size_t(n);
+    for (auto *hdr = reinterpret_cast<nlmsghdr *>(recv_buf_.data());
+         NLMSG_OK(hdr, len); hdr = NLMSG_NEXT(hdr, len)) {
+      if (hdr->nlmsg_type == family_id_) received = true;
+    }
+  }
+  return received;
+}
+
+ThermalEvents::ThermalEvents() : recv_buf_(RECV_BUF_SIZE) { open_netlink_(); }
+
+ThermalEvents::~ThermalEvents() {
+  if (nl_fd_ != -1) ::close(nl_fd_);
+}
+
+bool ThermalEvents::is_available() const { return nl_fd_ != -1; }
+
+bool ThermalEvents::wait(const std::vector<int> &sysfs_fds, int timeout_ms) {
+  pollfds_.clear();
+  if (nl_fd_ != -1) pollfds_.push_back(pollfd{nl_fd_, POLLIN, 0});
+  for (int fd : sysfs_fds) {
+    // poll ignores negative descriptors
+    pollfds_.push_back(pollfd{fd, POLLPRI, 0});
+  }
+  int ready = ::poll(pollfds_.data(), pollfds_.size(), timeout_ms);
+  if (ready <= 0) return false;
+
+  bool woken = false;
+  for (const auto &pfd : pollfds_) {
+    if (pfd.fd == nl_fd_) {
+      if ((pfd.revents & (POLLIN | POLLERR)) && drain_netlink_()) woken = true;
+    } else if (pfd.revents & POLLPRI) {
+      // sysfs_notify() on the attribute; the next read rearms it
+      woken = true;
+    }
+  }
+  return woken;
+}
+
+}  // namespace io
+
+}  // namespace templimiter
@@ -0,0 +1,111 @@
+/*
+    Copyright (c) 2019 Justin Collier
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thermal-events.h
+ * @author Justin Collier (jpcxist@gmail.com)
+ * @brief Provides the templimiter::io::ThermalEvents class
+ * @date created 2026-10-14
+ * @date modified 2026-10-14
+ */
+
+#pragma once
+
+#include <poll.h>
+#include <cstdint>
+#include <vector>
+
+namespace templimiter {
+
+namespace io {
+
+/**
+ * @brief Waits for thermal activity using the kernel thermal netlink family
+ * (trip point and temperature sampling events) and POLLPRI notifications on
+ * sysfs attributes
+ */
+class ThermalEvents {
+ private:
+  /** @brief Generic netlink socket, or -1 if unavailable */
+  int nl_fd_ = -1;
+
+  /** @brief Resolved id of the thermal generic netlink family */
+  uint16_t family_id_ = 0;
+
+  /** @brief Receive buffer for netlink messages */
+  std::vector<char> recv_buf_;
+
+  /** @brief Reusable poll descriptor list */
+  std::vector<pollfd> pollfds_;
+
+  /**
+   * @brief Opens the netlink socket and joins the thermal multicast groups
+   *
+   * @return true if at least one thermal group was joined
+   * @return false if thermal netlink is not supported
+   */
+  bool open_netlink_();
+
+  /**
+   * @brief Queries the generic netlink controller for the thermal family
+   *
+   * @param group_ids Ids of the thermal multicast groups found
+   * @return true if the family was resolved
+   * @return false if the family does not exist
+   */
+  bool resolve_family_(std::vector<uint32_t> &group_ids);
+
+  /**
+   * @brief Reads all pending netlink messages
+   *
+   * @return true if any thermal message was received
+   * @return false if none were received
+   */
+  bool drain_netlink_();
+
+ public:
+  /** @brief Construct a new ThermalEvents object */
+  ThermalEvents();
+
+  /** @brief Destroy the ThermalEvents object */
+  ~ThermalEvents();
+
+  ThermalEvents(const ThermalEvents &) = delete;
+  ThermalEvents &operator=(const ThermalEvents &) = delete;
+
+  /**
+   * @brief Returns whether or not thermal netlink events are being received
+   *
+   * @return true if subscribed to thermal netlink events
+   * @return false if only sysfs notifications are available
+   */
+  bool is_available() const;
+
+  /**
+   * @brief Waits until a thermal event occurs or the timeout expires
+   *
+   * @param sysfs_fds Open sysfs descriptors to watch for POLLPRI (negative
+   * descriptors are ignored)
+   * @param timeout_ms Maximum time to wait (in milliseconds)
+   * @return true if woken by a thermal event
+   * @return false if the timeout expired
+   */
+  bool wait(const std::vector<int> &sysfs_fds, int timeout_ms);
+};
+
+}  // namespace io
+
+}  // namespace templimiter
@@ -19,13 +19,15 @@
  * @author Justin Collier (jpcxist@gmail.com)
  * @brief Provides templimiter::tools functions that convert between types
  * @date created 2019-02-05
- * @date modified 2019-02-09
+ * @date modified 2026-10-14
  */
 
 #pragma once
 
+#include <charconv>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -37,22 +39,51 @@ namespace templimiter {
 namespace tools {
 
 /**
- * @brief Converts any value (not a string or a const char * or a bool) to a
- * string
+ * @brief Whether or not a type is an integer that is converted numerically
+ * (excludes bool and character types, which are streamed as characters)
  *
- * @tparam T Any type (not a string or const char * or a bool)
+ * @tparam T Any type
+ */
+template <typename T>
+constexpr bool is_numeric_integral_v =
+    std::is_integral_v<T> && !std::is_same_v<bool, T> &&
+    !std::is_same_v<char, T> && !std::is_same_v<signed char, T> &&
+    !std::is_same_v<unsigned char, T> && !std::is_same_v<wchar_t, T> &&
+    !std::is_same_v<char16_t, T> && !std::is_same_v<char32_t, T>;
+
+/**
+ * @brief Converts any value (not a string or a const char * or a bool or a
+ * numeric integral) to a string
+ *
+ * @tparam T Any type (not a string or const char * or a bool or a numeric
+ * integral)
  * @param input Input to convert to string
  * @return std::string
  */
 template <typename T, std::enable_if_t<!std::is_same_v<std::string, T> &&
                                        !std::is_same_v<const char *, T> &&
-                                       !std::is_same_v<bool, T>> * = nullptr>
+                                       !std::is_same_v<bool, T> &&
+                                       !is_numeric_integral_v<T>> * = nullptr>
 std::string to_string(const T &input) {
   std::ostringstream oss;
   oss << input;
   return oss.str();
 }
 
+/**
+ * @brief Converts any numeric integral to a string using std::to_chars
+ *
+ * @tparam T Numeric integral type
+ * @param input Input to convert to string
+ * @return std::string
+ */
+template <typename T, std::enable_if_t<is_numeric_integral_v<T>> * = nullptr>
+std::string to_string(const T &input) {
+  char buf[24];
+  auto result = std::to_chars(buf, buf + sizeof(buf), input);
+  return std::string(buf, result.ptr);
+}
+
 /**
  * @brief Returns the input of any (string to string) and (const char * to
  * string) conversion attempts
@@ -83,17 +114,19 @@ std::string to_string(const T &input) {
 }
 
 /**
- * @brief Converts any precise value (not a string or a const char * or a bool)
- * to a string
+ * @brief Converts any precise value (not a string or a const char * or a bool
+ * or a numeric integral) to a string
  *
- * @tparam T Any type (not a string or const char * or a bool)
+ * @tparam T Any type (not a string or const char * or a bool or a numeric
+ * integral)
  * @param input Input to convert to string
  * @param precision Precision specified for ostringstream
  * @return std::string
  */
 template <typename T, std::enable_if_t<!std::is_same_v<std::string, T> &&
                                        !std::is_same_v<const char *, T> &&
-                                       !std::is_same_v<bool, T>> * = nullptr>
+                                       !std::is_same_v<bool, T> &&
+                                       !is_numeric_integral_v<T>> * = nullptr>
 std::string to_string(const T &input, const std::streamsize precision) {
   std::ostringstream oss;
   oss.precision(precision);
@@ -101,6 +134,20 @@ std::string to_string(const T &input, const std::streamsize precision) {
   return oss.str();
 }
 
+/**
+ * @brief Converts any numeric integral to a string using std::to_chars
+ *
+ * @tparam T Numeric integral type
+ * @param input Input to convert to string
+ * @param precision Precision specified for ostringstream (unused)
+ * @return std::string
+ */
+template <typename T, std::enable_if_t<is_numeric_integral_v<T>> * = nullptr>
+std::string to_string(const T &input,
+                      [[maybe_unused]] std::streamsize precision) {
+  return to_string(input);
+}
+
 /**
  * @brief Returns the input of any (string to string) and (const char * to
  * string) precise conversion attempts
@@ -137,7 +184,8 @@ std::string to_string(const T &input,
 /**
  * @brief Converts any value of any type to another type, so long as the types
  * to/from are not the same and the conversion is not from a const char * to a
- * string, a bool to a string, or a string to a bool
+ * string, a bool to a string, a string to a bool, or between a string and a
+ * numeric integral
  *
  * @tparam T_to Type converting to
  * @tparam T_from Type converting from
@@ -152,6 +200,11 @@ template <
            std::is_same_v<std::string, T_to>) ||
           (std::is_same_v<bool, T_from> && std::is_same_v<std::string, T_to>) ||
           (std::is_same_v<std::string, T_from> && std::is_same_v<bool, T_to>) ||
+          (std::is_same_v<std::string, T_from> &&
+           is_numeric_integral_v<T_to>) ||
+          (is_numeric_integral_v<T_from> &&
+           std::is_same_v<std::string, T_to>) ||
+          std::is_same_v<std::string_view, T_from> ||
           std::is_same_v<T_to, T_from>)> * = nullptr>
 T_to convert(const T_from &input) {
   // define output
@@ -222,10 +275,81 @@ T_to convert(const T_from &input) {
   return output;
 }
 
+/**
+ * @brief Converts a string view to a numeric integral using std::from_chars
+ *
+ * @tparam T_to Numeric integral type converting to
+ * @param input Input to convert (must consist entirely of the number)
+ * @return T_to
+ * @throw templimiter::error::TypeError if type conversion fails
+ */
+template <typename T_to,
+          std::enable_if_t<is_numeric_integral_v<T_to>> * = nullptr>
+T_to convert(std::string_view input) {
+  T_to output{};
+  const char *last = input.data() + input.size();
+  auto result = std::from_chars(input.data(), last, output);
+  // Leading zeros ("007", "-0") never survived the former to_string round
+  // trip, so they are still rejected
+  size_t first_digit = !input.empty() && input[0] == '-' ? 1 : 0;
+  bool is_padded = input.size() > first_digit && input[first_digit] == '0' &&
+                   (first_digit == 1 || input.size() > 1);
+  if (input.empty() || result.ec != std::errc() || result.ptr != last ||
+      is_padded) {
+    throw error::TypeError(typeid(T_to).name(), typeid(std::string).name());
+  }
+  return output;
+}
+
+/**
+ * @brief Converts a string view to a string
+ *
+ * @tparam T_to std::string
+ * @param input Input to convert
+ * @return T_to
+ */
+template <typename T_to,
+          std::enable_if_t<std::is_same_v<std::string, T_to>> * = nullptr>
+T_to convert(std::string_view input) {
+  return std::string(input);
+}
+
+/**
+ * @brief Converts a string to a numeric integral using std::from_chars
+ *
+ * @tparam T_to Numeric integral type converting to
+ * @tparam T_from std::string
+ * @param input Input to convert
+ * @return T_to
+ * @throw templimiter::error::TypeError if type conversion fails
+ */
+template <typename T_to, typename T_from,
+          std::enable_if_t<std::is_same_v<std::string, T_from> &&
+                           is_numeric_integral_v<T_to>> * = nullptr>
+T_to convert(const T_from &input) {
+  return convert<T_to>(std::string_view(input));
+}
+
+/**
+ * @brief Converts a numeric integral to a string using std::to_chars
+ *
+ * @tparam T_to std::string
+ * @tparam T_from Numeric integral type converting from
+ * @param input Input to convert
+ * @return T_to
+ */
+template <typename T_to, typename T_from,
+          std::enable_if_t<is_numeric_integral_v<T_from> &&
+                           std::is_same_v<std::string, T_to>> * = nullptr>
+T_to convert(const T_from &input) {
+  return to_string(input);
+}
+
 /**
  * @brief Converts any precise value of any type to another type, so long as the
  * types to/from are not the same and the conversion is not from a const char *
- * to a string, a bool to a string, or a string to a bool
+ * to a string, a bool to a string, a string to a bool, or between a string and
+ * a numeric integral
  *
  * @tparam T_to Type converting to
  * @tparam T_from Type converting from
@@ -241,6 +365,11 @@ template <
            std::is_same_v<std::string, T_to>) ||
           (std::is_same_v<bool, T_from> && std::is_same_v<std::string, T_to>) ||
           (std::is_same_v<std::string, T_from> && std::is_same_v<bool, T_to>) ||
+          (std::is_same_v<std::string, T_from> &&
+           is_numeric_integral_v<T_to>) ||
+          (is_numeric_integral_v<T_from> &&
+           std::is_same_v<std::string, T_to>) ||
+          std::is_same_v<std::string_view, T_from> ||
           std::is_same_v<T_to, T_from>)> * = nullptr>
 T_to convert(const T_from &input, std::streamsize precision) {
   // define output
@@ -317,6 +446,41 @@ T_to convert(const T_from &input, [[maybe_unused]] std::streamsize precision) {
   return output;
 }
 
+/**
+ * @brief Converts a string to a numeric integral using std::from_chars (with
+ * precision mistakenly specified)
+ *
+ * @tparam T_to Numeric integral type converting to
+ * @tparam T_from std::string
+ * @param input Input to convert
+ * @param precision Precision specified for ostringstream (unused)
+ * @return T_to
+ * @throw templimiter::error::TypeError if type conversion fails
+ */
+template <typename T_to, typename T_from,
+          std::enable_if_t<std::is_same_v<std::string, T_from> &&
+                           is_numeric_integral_v<T_to>> * = nullptr>
+T_to convert(const T_from &input, [[maybe_unused]] std::streamsize precision) {
+  return convert<T_to>(std::string_view(input));
+}
+
+/**
+ * @brief Converts a numeric integral to a string using std::to_chars (with
+ * precision mistakenly specified)
+ *
+ * @tparam T_to std::string
+ * @tparam T_from Numeric integral type converting from
+ * @param input Input to convert
+ * @param precision Precision specified for ostringstream (unused)
+ * @return T_to
+ */
+template <typename T_to, typename T_from,
+          std::enable_if_t<is_numeric_integral_v<T_from> &&
+                           std::is_same_v<std::string, T_to>> * = nullptr>
+T_to convert(const T_from &input, [[maybe_unused]] std::streamsize precision) {
+  return to_string(input);
+}
+
 /**
  * @brief Converts any vector of any type to a vector of another type, so long
  * as the types to/from are not the same and the conversion is not from a const
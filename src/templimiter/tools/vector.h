@@ -167,6 +167,18 @@ std::vector<T> fill(size_t size, const T &fill_val) {
   return vect;
 }
 
+/**
+ * @brief Empties a container and gives its memory back; clear() keeps the
+ * capacity, so the container is swapped with an empty one instead
+ *
+ * @tparam T Type of container
+ * @param container Container to empty
+ */
+template <typename T>
+void free_memory(T &container) {
+  T().swap(container);
+}
+
 /**
  * @brief Returns the max n elements of a vector sorted in descending order
  *